@@ -0,0 +1,51 @@
+#pragma once
+
+// Minimal timing helpers shared by the benchmark programs. The benchmarks are
+// standalone executables that print a table of results, they are built
+// together with the tests but never executed by ctest.
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#if defined(_MSC_VER)
+    #define BENCH_NOINLINE __declspec(noinline)
+#else
+    #define BENCH_NOINLINE __attribute__((noinline))
+#endif
+
+namespace bench
+{
+    // Prevents the compiler from optimizing away a computed value. With GCC and
+    // Clang it also makes the compiler assume that any memory may have changed,
+    // so loops over unchanged data are not hoisted out of the benchmark.
+    template <class T>
+    inline void do_not_optimize(T const& value)
+    {
+#if defined(__GNUC__)
+        asm volatile("" : : "r"(&value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+    // Runs f iterations times and prints the average time per iteration.
+    // Returns the average time per iteration in nanoseconds.
+    template <class F>
+    double run(std::string const& name, std::size_t iterations, F&& f)
+    {
+        // Warm up caches, lazily initialized statics, allocator pools
+        for (std::size_t i = 0; i < iterations / 10 + 1; i++)
+            f();
+
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < iterations; i++)
+            f();
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        double ns = std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+        std::printf("%-48s %12.1f ns/op\n", name.c_str(), ns);
+        return ns;
+    }
+}
@@ -0,0 +1,98 @@
+#include <go/go_error.hpp>
+#include <go/error_channel.hpp>
+
+#include "bench.hpp"
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Hands errors from N producer threads to one consumer, through go::error_channel
+// and through a mutex guarded deque, and reports the time per pushed error. The
+// channel drops errors when the consumer falls behind, so it's measured both as is
+// and with producers retrying until their error is delivered.
+
+constexpr std::size_t per_producer = 200000;
+
+template <class Push, class Drain>
+auto run_producers(std::string const& name, int producers, Push&& push, Drain&& drain) -> void
+{
+    std::atomic<int> running{producers};
+    std::vector<std::thread> threads;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < producers; t++)
+    {
+        threads.emplace_back([&] {
+            // Own error per producer, so that producers don't share a reference count
+            auto err = go::errorf("worker failed");
+            for (std::size_t i = 0; i < per_producer; i++)
+                push(go::error(err));
+
+            running--;
+        });
+    }
+
+    std::size_t received = 0;
+    while (running.load() != 0)
+        received += drain();
+
+    for (auto& thread : threads)
+        thread.join();
+
+    received += drain();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    auto total = per_producer * producers;
+    double ns = std::chrono::duration<double, std::nano>(elapsed).count() / total;
+    std::printf("%-48s %12.1f ns/op %10.2f%% delivered\n", name.c_str(), ns, 100.0 * received / total);
+}
+
+int main()
+{
+    for (int producers : {1, 2, 4, 8, 16, 32, 64})
+    {
+        go::error_channel channel(1 << 14);
+        std::vector<go::error> batch;
+        batch.reserve(1 << 14);
+
+        run_producers("error_channel, " + std::to_string(producers) + " producers", producers,
+            [&](go::error&& err) { channel.try_push(std::move(err)); },
+            [&] {
+                batch.clear();
+                return channel.drain(batch);
+            });
+
+        run_producers("error_channel retrying, " + std::to_string(producers) + " producers", producers,
+            [&](go::error&& err) {
+                while (!channel.try_push(std::move(err)))
+                    std::this_thread::yield();
+            },
+            [&] {
+                batch.clear();
+                return channel.drain(batch);
+            });
+
+        std::mutex mutex;
+        std::deque<go::error> queue;
+        std::deque<go::error> taken;
+
+        run_producers("mutex + deque, " + std::to_string(producers) + " producers", producers,
+            [&](go::error&& err) {
+                std::lock_guard<std::mutex> lock(mutex);
+                queue.push_back(std::move(err));
+            },
+            [&] {
+                taken.clear();
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    taken.swap(queue);
+                }
+                return taken.size();
+            });
+    }
+
+    return 0;
+}
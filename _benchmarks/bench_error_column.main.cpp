@@ -0,0 +1,66 @@
+#include <go/go_error.hpp>
+#include <go/error_column.hpp>
+
+#include "bench.hpp"
+
+#include <vector>
+
+// Compares a vector with an error per row with a column of a batch
+// where one row in a thousand failed.
+
+int main()
+{
+    constexpr std::size_t rows = 64 * 1024;
+    constexpr std::size_t iterations = 2000;
+
+    std::vector<go::error> vec(rows);
+    go::error_column column(rows);
+
+    auto errInvalid = go::errorf("invalid");
+    for (std::size_t row = 999; row < rows; row += 1000)
+    {
+        vec[row] = errInvalid;
+        column.set(row, errInvalid);
+    }
+
+    bench::run("vector: any failure in the second half", iterations, [&] {
+        bool any = false;
+        for (std::size_t row = rows / 2 + 1; row < rows / 2 + 999; row++)
+            any |= static_cast<bool>(vec[row]);
+        bench::do_not_optimize(any);
+    });
+
+    bench::run("column: any failure in the second half", iterations, [&] {
+        bench::do_not_optimize(column.any(rows / 2 + 1, rows / 2 + 999));
+    });
+
+    bench::run("vector: count failures", iterations, [&] {
+        std::size_t count = 0;
+        for (auto& err : vec)
+            count += err ? 1 : 0;
+        bench::do_not_optimize(count);
+    });
+
+    bench::run("column: count failures", iterations, [&] {
+        bench::do_not_optimize(column.count(0, rows));
+    });
+
+    bench::run("vector: first failure after the last one", iterations, [&] {
+        auto found = rows;
+        for (std::size_t row = rows - 536; row < rows; row++)
+        {
+            if (vec[row])
+            {
+                found = row;
+                break;
+            }
+        }
+        bench::do_not_optimize(found);
+    });
+
+    bench::run("column: first failure after the last one", iterations, [&] {
+        bench::do_not_optimize(column.first_error(rows - 536));
+    });
+
+    return 0;
+}
@@ -0,0 +1,95 @@
+#include <go/go_error.hpp>
+#include <go/error_set.hpp>
+
+#include "bench.hpp"
+
+#include <system_error>
+
+// Compares returning and dispatching on a closed error_set with the open
+// go::error path, at different failure rates.
+
+struct error_parse_data : public go::error_interface
+{
+    int line;
+
+    explicit error_parse_data(int line) : line(line) {}
+
+    std::string message() const override { return "parse error at line " + std::to_string(line); }
+};
+
+using error_parse = go::error_of<error_parse_data>;
+
+using parse_result = go::error_set<go::error_code, error_parse>;
+
+BENCH_NOINLINE auto parse_open(int i, int failEvery) -> go::error
+{
+    if (i % failEvery != 0)
+        return {};
+
+    if (i % 2 == 0)
+        return go::make_error<error_parse>(i);
+
+    return go::make_error<go::error_code>(std::make_error_code(std::errc::invalid_argument));
+}
+
+BENCH_NOINLINE auto parse_closed(int i, int failEvery) -> parse_result
+{
+    if (i % failEvery != 0)
+        return {};
+
+    if (i % 2 == 0)
+        return parse_result::make<error_parse>(i);
+
+    return parse_result::make<go::error_code>(std::make_error_code(std::errc::invalid_argument));
+}
+
+int main()
+{
+    constexpr std::size_t iterations = 20;
+    constexpr int calls = 100000;
+
+    for (int failEvery : {1, 10, 1000})
+    {
+        auto suffix = ", 1 in " + std::to_string(failEvery) + " fails";
+
+        bench::run("open go::error + as_error" + suffix, iterations, [&] {
+            long lines = 0;
+            for (int i = 0; i < calls; i++)
+            {
+                auto err = parse_open(i, failEvery);
+                if (!err)
+                    continue;
+
+                error_parse parse;
+                if (go::as_error(err, parse))
+                    lines += parse->line;
+            }
+            bench::do_not_optimize(lines);
+        });
+
+        bench::run("open go::error + error_cast" + suffix, iterations, [&] {
+            long lines = 0;
+            for (int i = 0; i < calls; i++)
+            {
+                auto err = parse_open(i, failEvery);
+                if (auto parse = go::error_cast<error_parse_data*>(err))
+                    lines += parse->line;
+            }
+            bench::do_not_optimize(lines);
+        });
+
+        bench::run("error_set + match" + suffix, iterations, [&] {
+            long lines = 0;
+            for (int i = 0; i < calls; i++)
+            {
+                lines += parse_closed(i, failEvery).match(
+                    [](go::no_error) { return 0; },
+                    [](go::error_code_data const&) { return 0; },
+                    [](error_parse_data const& parse) { return parse.line; });
+            }
+            bench::do_not_optimize(lines);
+        });
+    }
+
+    return 0;
+}
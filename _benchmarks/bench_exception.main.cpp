@@ -0,0 +1,81 @@
+#include <go/go_error.hpp>
+#include <go/exception.hpp>
+
+#include "bench.hpp"
+
+#include <stdexcept>
+#include <string>
+
+// Compares failing by throwing an exception with failing by returning an error,
+// at different failure rates, to quantify migrating a code path to errors.
+
+auto errInvalid = go::errorf("invalid record");
+
+BENCH_NOINLINE auto parse_throwing(int i, int failEvery) -> int
+{
+    if (i % failEvery == 0)
+        throw std::runtime_error("invalid record");
+
+    return i;
+}
+
+BENCH_NOINLINE auto parse_returning(int i, int failEvery, int& out) -> go::error
+{
+    if (i % failEvery == 0)
+        return errInvalid;
+
+    out = i;
+    return {};
+}
+
+int main()
+{
+    constexpr std::size_t iterations = 20;
+    constexpr int calls = 100000;
+
+    for (int failEvery : {2, 10, 100, 1000, 1000000})
+    {
+        auto suffix = ", 1 in " + std::to_string(failEvery) + " fails";
+
+        bench::run("throw/catch" + suffix, iterations, [&] {
+            long sum = 0;
+            for (int i = 1; i <= calls; i++)
+            {
+                try
+                {
+                    sum += parse_throwing(i, failEvery);
+                }
+                catch (std::exception const&)
+                {
+                    sum--;
+                }
+            }
+            bench::do_not_optimize(sum);
+        });
+
+        bench::run("error return" + suffix, iterations, [&] {
+            long sum = 0;
+            for (int i = 1; i <= calls; i++)
+            {
+                int value = 0;
+                if (auto err = parse_returning(i, failEvery, value))
+                    sum--;
+                else
+                    sum += value;
+            }
+            bench::do_not_optimize(sum);
+        });
+
+        bench::run("catch_as_error at the boundary" + suffix, iterations, [&] {
+            long sum = 0;
+            for (int i = 1; i <= calls; i++)
+            {
+                auto [value, err] = go::catch_as_error([&] { return parse_throwing(i, failEvery); });
+                sum += err ? -1 : value;
+            }
+            bench::do_not_optimize(sum);
+        });
+    }
+
+    return 0;
+}
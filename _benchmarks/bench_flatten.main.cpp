@@ -0,0 +1,64 @@
+#include <go/go_error.hpp>
+#include <go/flatten.hpp>
+
+#include "bench.hpp"
+
+// Compares repeated queries and rendering of a config validation error
+// on the error itself and on its flattened snapshot.
+
+struct error_port_data : public go::error_interface
+{
+    std::string message() const override { return "port is out of range"; }
+};
+
+using error_port = go::error_of<error_port_data>;
+
+int main()
+{
+    constexpr std::size_t iterations = 20000;
+
+    auto errMissing = go::errorf("missing");
+
+    go::error err;
+    for (int i = 0; i < 50; i++)
+    {
+        auto child = go::wrap_error(go::wrap_error(go::errorf("field ", i, " is invalid"), "parsing"), "validating");
+        err = go::append_error(std::move(err), std::move(child));
+    }
+
+    err = go::append_error(std::move(err), go::wrap_error(go::make_error<error_port>(), "listen"));
+
+    auto snapshot = go::flatten(err);
+
+    bench::run("flatten, 50 children", 2000, [&] {
+        bench::do_not_optimize(go::flatten(err));
+    });
+
+    bench::run("is_error miss on error", iterations, [&] {
+        bench::do_not_optimize(go::is_error(err, errMissing));
+    });
+
+    bench::run("is_error miss on snapshot", iterations, [&] {
+        bench::do_not_optimize(go::is_error(snapshot, errMissing));
+    });
+
+    bench::run("as_error on error", iterations, [&] {
+        error_port port;
+        bench::do_not_optimize(go::as_error(err, port));
+    });
+
+    bench::run("as_error on snapshot", iterations, [&] {
+        error_port port;
+        bench::do_not_optimize(go::as_error(snapshot, port));
+    });
+
+    bench::run("message() on error", 2000, [&] {
+        bench::do_not_optimize(err.message());
+    });
+
+    bench::run("message() on snapshot", 2000, [&] {
+        bench::do_not_optimize(snapshot.message());
+    });
+
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include <go/go_error.hpp>
+
+#include "bench.hpp"
+
+#include <system_error>
+
+// Compares asking whether a wrap chain contains an error type with as_error,
+// which copies the found error into a target, and with has_error, for a final
+// error type, compared by type ID, and a non-final one, found with dynamic_cast.
+
+struct error_retryable_data final : public go::error_interface
+{
+    auto message() const -> std::string override { return "retryable"; }
+};
+
+using error_retryable = go::error_of<error_retryable_data>;
+
+auto chain(go::error root, int depth) -> go::error
+{
+    go::error err = std::move(root);
+    for (int i = 0; i < depth; i++)
+        err = go::wrap_error(std::move(err), "calling service layer " + std::to_string(i));
+
+    return err;
+}
+
+int main()
+{
+    constexpr std::size_t iterations = 1000000;
+    constexpr int depth = 5;
+
+    auto code = chain(go::make_error<go::error_code>(std::make_error_code(std::errc::timed_out)), depth);
+    auto retryable = chain(go::make_error<error_retryable>(), depth);
+
+    bench::run("as_error error_code", iterations, [&] {
+        go::error_code target;
+        auto found = go::as_error(code, target);
+        bench::do_not_optimize(found);
+    });
+
+    bench::run("has_error error_code", iterations, [&] {
+        auto found = go::has_error<go::error_code>(code);
+        bench::do_not_optimize(found);
+    });
+
+    bench::run("as_error final type", iterations, [&] {
+        error_retryable target;
+        auto found = go::as_error(retryable, target);
+        bench::do_not_optimize(found);
+    });
+
+    bench::run("has_error final type", iterations, [&] {
+        auto found = go::has_error<error_retryable>(retryable);
+        bench::do_not_optimize(found);
+    });
+
+    bench::run("has_error final type, not found", iterations, [&] {
+        auto found = go::has_error<error_retryable>(code);
+        bench::do_not_optimize(found);
+    });
+
+    return 0;
+}
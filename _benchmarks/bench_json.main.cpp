@@ -0,0 +1,44 @@
+#include <go/go_error.hpp>
+#include <go/json.hpp>
+
+#include "bench.hpp"
+
+// Compares streaming a wide multi error as JSON with rendering its message,
+// which is what callers did before to escape it themselves.
+
+int main()
+{
+    constexpr std::size_t iterations = 2000;
+
+    go::error err;
+    for (int i = 0; i < 1000; i++)
+    {
+        auto child = go::wrap_error(go::errorf("field ", i, " is \"invalid\""), "validating");
+        err = go::append_error(std::move(err), std::move(child));
+    }
+
+    bench::run("message(), 1000 children", iterations, [&] {
+        bench::do_not_optimize(err.message());
+    });
+
+    bench::run("message() + write_json_string, 1000 children", iterations, [&] {
+        std::string out;
+        go::write_json_string(out, err.message());
+        bench::do_not_optimize(out);
+    });
+
+    bench::run("write_json, 1000 children", iterations, [&] {
+        std::string out;
+        go::write_json(err, out);
+        bench::do_not_optimize(out);
+    });
+
+    std::string reused;
+    bench::run("write_json into a reused buffer, 1000 children", iterations, [&] {
+        reused.clear();
+        go::write_json(err, reused);
+        bench::do_not_optimize(reused);
+    });
+
+    return 0;
+}
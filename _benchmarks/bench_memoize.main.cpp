@@ -0,0 +1,95 @@
+#include <go/go_error.hpp>
+
+#include "bench.hpp"
+
+#include <string>
+
+// Compares rendering the message of a wrap chain several times, as happens when
+// an error is logged, counted and returned, with memoized wrap_error frames and
+// with an equivalent wrapper that renders its message on every call.
+
+struct plain_wrapper_data : public go::error_interface
+{
+    plain_wrapper_data(go::error inner, std::string context) :
+        inner(std::move(inner)), context(std::move(context))
+    {}
+
+    auto message() const -> std::string override { return context + ": " + inner.message(); }
+    auto unwrap() const -> go::error override { return inner; }
+
+    go::error inner;
+    std::string context;
+};
+
+using plain_wrapper = go::error_of<plain_wrapper_data>;
+
+auto errRoot = go::errorf("connection reset by peer");
+
+auto memoized_chain(int depth) -> go::error
+{
+    go::error err = errRoot;
+    for (int i = 0; i < depth; i++)
+        err = go::wrap_error(std::move(err), "calling service layer " + std::to_string(i));
+
+    return err;
+}
+
+auto plain_chain(int depth) -> go::error
+{
+    go::error err = errRoot;
+    for (int i = 0; i < depth; i++)
+        err = go::make_error<plain_wrapper>(std::move(err), "calling service layer " + std::to_string(i));
+
+    return err;
+}
+
+int main()
+{
+    constexpr std::size_t iterations = 100000;
+    constexpr int depth = 10;
+
+    for (int renders : {1, 3})
+    {
+        auto suffix = ", " + std::to_string(renders) + " renders";
+
+        bench::run("build and render plain chain" + suffix, iterations, [&] {
+            auto err = plain_chain(depth);
+            for (int i = 0; i < renders; i++)
+            {
+                auto msg = err.message();
+                bench::do_not_optimize(msg);
+            }
+        });
+
+        bench::run("build and render memoized chain" + suffix, iterations, [&] {
+            auto err = memoized_chain(depth);
+            for (int i = 0; i < renders; i++)
+            {
+                auto msg = err.message();
+                bench::do_not_optimize(msg);
+            }
+        });
+    }
+
+    auto plain = plain_chain(depth);
+    auto memoized = memoized_chain(depth);
+    std::string out;
+
+    bench::run("message() of rendered plain chain", iterations, [&] {
+        auto msg = plain.message();
+        bench::do_not_optimize(msg);
+    });
+
+    bench::run("message() of rendered memoized chain", iterations, [&] {
+        auto msg = memoized.message();
+        bench::do_not_optimize(msg);
+    });
+
+    bench::run("append_message of rendered memoized chain", iterations, [&] {
+        out.clear();
+        go::append_message(out, memoized);
+        bench::do_not_optimize(out);
+    });
+
+    return 0;
+}
@@ -0,0 +1,127 @@
+#include <go/go_error.hpp>
+
+#include "bench.hpp"
+
+#include <system_error>
+#include <vector>
+
+// Measures how is_error, as_error and message() of a list of 10^5 validation
+// errors scale with the number of threads of the pool, against the sequential
+// functions. The target of is_error and as_error is the last error of the list,
+// so the whole list is searched. The list and its records don't memoize their
+// messages, so that every iteration renders all of them.
+
+constexpr std::size_t listSize = 100000;
+
+auto errTarget = go::errorf("checksum mismatch");
+
+struct record_error_data : public go::error_interface
+{
+    record_error_data(go::error inner, std::size_t record) :
+        inner(std::move(inner)), record(record)
+    {}
+
+    auto message() const -> std::string override { return "record " + std::to_string(record) + ": " + inner.message(); }
+    auto unwrap() const -> go::error override { return inner; }
+
+    go::error inner;
+    std::size_t record;
+};
+
+using record_error = go::error_of<record_error_data>;
+
+struct bulk_error_data : public go::error_interface, public go::composite_message_interface
+{
+    explicit bulk_error_data(std::vector<go::error> errs) :
+        errs(std::move(errs))
+    {}
+
+    auto message() const -> std::string override
+    {
+        std::string msg = "invalid records:\n";
+        for (auto& err : errs)
+        {
+            msg += "\t* ";
+            msg += err.message();
+            msg += '\n';
+        }
+
+        return msg;
+    }
+
+    auto message_layout() const -> go::message_layout override
+    {
+        return {"invalid records:\n", "\t* ", "", "\n", ""};
+    }
+
+    auto unwrap_span() const -> go::error_span override { return errs; }
+
+    std::vector<go::error> errs;
+};
+
+using bulk_error = go::error_of<bulk_error_data>;
+
+auto validation_errors() -> go::error
+{
+    std::vector<go::error> errs;
+    for (std::size_t i = 0; i < listSize; i++)
+    {
+        auto inner = i + 1 == listSize
+            ? go::make_error<go::error_code>(std::make_error_code(std::errc::invalid_argument))
+            : go::errorf("field ", i % 7, " is out of range");
+
+        errs.push_back(go::make_error<record_error>(std::move(inner), i));
+    }
+
+    return go::make_error<bulk_error>(std::move(errs));
+}
+
+int main()
+{
+    constexpr std::size_t iterations = 20;
+
+    auto err = validation_errors();
+    auto maxThreads = std::max<std::size_t>(go::thread_pool::default_size(), 4);
+
+    std::printf("%zu hardware threads\n", go::thread_pool::default_size());
+
+    bench::run("is_error", iterations, [&] {
+        auto found = go::is_error(err, errTarget);
+        bench::do_not_optimize(found);
+    });
+
+    bench::run("as_error", iterations, [&] {
+        go::error_code target;
+        auto found = go::as_error(err, target);
+        bench::do_not_optimize(found);
+    });
+
+    bench::run("message()", iterations, [&] {
+        auto msg = err.message();
+        bench::do_not_optimize(msg);
+    });
+
+    for (std::size_t threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        go::thread_pool pool(threads);
+        auto suffix = ", " + std::to_string(threads) + " threads";
+
+        bench::run("parallel_is_error" + suffix, iterations, [&] {
+            auto found = go::parallel_is_error(err, errTarget, pool);
+            bench::do_not_optimize(found);
+        });
+
+        bench::run("parallel_as_error" + suffix, iterations, [&] {
+            go::error_code target;
+            auto found = go::parallel_as_error(err, target, pool);
+            bench::do_not_optimize(found);
+        });
+
+        bench::run("parallel_message" + suffix, iterations, [&] {
+            auto msg = go::parallel_message(err, pool);
+            bench::do_not_optimize(msg);
+        });
+    }
+
+    return 0;
+}
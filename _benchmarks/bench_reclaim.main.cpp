@@ -0,0 +1,87 @@
+#include <go/go_error.hpp>
+#include <go/reclaim.hpp>
+
+#include "bench.hpp"
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+// Measures the cost of releasing errors: the fast path of dropping a single
+// error, and the time a thread spends dropping a large tree with and without
+// a background_reclaimer.
+
+struct node_data : public go::error_interface
+{
+    explicit node_data(go::error inner) : inner(std::move(inner)) {}
+
+    auto message() const -> std::string override { return "node"; }
+    auto unwrap() const -> go::error override { return inner; }
+
+    go::error inner;
+};
+
+using node = go::error_of<node_data>;
+
+// The same chain built from plain shared_ptrs, destroyed recursively
+struct raw_node
+{
+    std::shared_ptr<raw_node> inner;
+};
+
+auto make_chain(std::size_t depth) -> go::error
+{
+    go::error err;
+    for (std::size_t i = 0; i < depth; i++)
+        err = go::make_error<node>(std::move(err));
+
+    return err;
+}
+
+// Times only the release of trees built outside of the measured interval
+auto time_release(std::string const& name, std::size_t iterations, std::size_t depth) -> void
+{
+    double total = 0;
+    for (std::size_t i = 0; i < iterations; i++)
+    {
+        auto err = make_chain(depth);
+
+        auto start = std::chrono::steady_clock::now();
+        err = {};
+        total += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    std::printf("%-48s %12.1f ns/op\n", name.c_str(), total / iterations);
+}
+
+int main()
+{
+    constexpr std::size_t iterations = 100000;
+
+    bench::run("create and drop errorf", iterations, [] {
+        auto err = go::errorf("failed");
+        bench::do_not_optimize(err);
+    });
+
+    bench::run("create and drop 10 deep chain", iterations / 10, [] {
+        auto err = make_chain(10);
+        bench::do_not_optimize(err);
+    });
+
+    bench::run("create and drop 10 deep shared_ptr chain", iterations / 10, [] {
+        std::shared_ptr<raw_node> head;
+        for (int i = 0; i < 10; i++)
+            head = std::make_shared<raw_node>(raw_node{std::move(head)});
+        bench::do_not_optimize(head);
+    });
+
+    time_release("release 100k deep chain", 20, 100000);
+
+    {
+        go::background_reclaimer reclaimer;
+        time_release("release 100k deep chain, reclaimer", 20, 100000);
+        reclaimer.flush();
+    }
+
+    return 0;
+}
@@ -0,0 +1,59 @@
+#include <go/go_error.hpp>
+
+#include "bench.hpp"
+
+#include <chrono>
+#include <string>
+
+// Compares logging a large list of errors by rendering its whole message and
+// cutting it to a log line with rendering it within the budget of the line.
+
+auto make_list(int size) -> go::error
+{
+    go::error err;
+    for (int i = 0; i < size; i++)
+        err = go::append_error(std::move(err), go::wrap_error(go::errorf("row ", i, " is invalid"), "validating batch"));
+
+    return err;
+}
+
+// Times only rendering, every time on a fresh list, as messages are memoized
+template <class F>
+auto time_rendering(std::string const& name, std::size_t iterations, int size, F&& f) -> void
+{
+    double total = 0;
+    for (std::size_t i = 0; i < iterations; i++)
+    {
+        auto err = make_list(size);
+
+        auto start = std::chrono::steady_clock::now();
+        auto line = f(err);
+        total += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        bench::do_not_optimize(line);
+    }
+
+    std::printf("%-48s %12.1f ns/op\n", name.c_str(), total / iterations);
+}
+
+int main()
+{
+    constexpr std::size_t lineSize = 4096;
+
+    for (int size : {10, 1000, 50000})
+    {
+        auto suffix = ", " + std::to_string(size) + " errors";
+        std::size_t iterations = size >= 50000 ? 20 : 1000;
+
+        time_rendering("message() then cut" + suffix, iterations, size, [&](go::error const& err) {
+            auto line = err.message();
+            line.resize(std::min(line.size(), lineSize));
+            return line;
+        });
+
+        time_rendering("render()" + suffix, iterations, size, [&](go::error const& err) {
+            return go::render(err, lineSize);
+        });
+    }
+
+    return 0;
+}
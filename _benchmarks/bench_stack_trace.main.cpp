@@ -0,0 +1,62 @@
+#include <go/go_error.hpp>
+#include <go/stack_trace.hpp>
+
+#include "bench.hpp"
+
+// Measures how much recording a stack trace adds to error creation, at full
+// and sampled capture rates, and how expensive the deferred symbolization is.
+
+struct error_bench_data : public go::error_interface
+{
+    int value;
+
+    explicit error_bench_data(int value) : value(value) {}
+
+    auto message() const -> std::string override { return "bench"; }
+};
+
+using error_bench = go::error_of<error_bench_data>;
+
+// Adds a few frames to the stack, like a real call site would have
+template <int Depth>
+go::error nested(go::trace_sampler* site)
+{
+    if constexpr (Depth == 0)
+    {
+        if (!site)
+            return go::make_error<error_bench>(Depth);
+
+        return go::make_traced_error<error_bench>(*site, Depth);
+    }
+    else
+    {
+        auto err = nested<Depth - 1>(site);
+        bench::do_not_optimize(err);
+        return err;
+    }
+}
+
+int main()
+{
+    constexpr std::size_t iterations = 200000;
+
+    bench::run("make_error", iterations, [] {
+        bench::do_not_optimize(nested<8>(nullptr));
+    });
+
+    for (std::uint32_t rate : {1u, 10u, 100u, 1000u})
+    {
+        go::trace_sampler site(rate);
+        bench::run("make_traced_error, 1 in " + std::to_string(rate), iterations, [&] {
+            bench::do_not_optimize(nested<8>(&site));
+        });
+    }
+
+    go::trace_sampler always;
+    auto err = nested<8>(&always);
+    bench::run("stack_trace::to_string", 1000, [&] {
+        bench::do_not_optimize(go::find_stack_trace(err)->to_string());
+    });
+
+    return 0;
+}
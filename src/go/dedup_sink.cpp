@@ -0,0 +1,184 @@
+#include <go/dedup_sink.hpp>
+#include <go/wrap.hpp>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <mutex>
+#include <typeinfo>
+#include <unordered_map>
+
+namespace go
+{
+    namespace
+    {
+        // Expired windows without repeats are forgotten once a shard grows past this
+        constexpr std::size_t sweep_threshold = 1024;
+
+        auto mix(std::uint64_t h) -> std::uint64_t
+        {
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdULL;
+            h ^= h >> 33;
+            h *= 0xc4ceb9fe1a85ec53ULL;
+            h ^= h >> 33;
+            return h;
+        }
+
+        struct pending_summary
+        {
+            error err;
+            std::uint64_t fingerprint;
+            std::uint64_t repeats;
+        };
+    }
+
+    struct alignas(64) dedup_sink::shard
+    {
+        struct window
+        {
+            clock::time_point start;
+            std::uint64_t repeats = 0;
+            error first;
+        };
+
+        std::mutex mutex;
+        std::unordered_map<std::uint64_t, window> windows;
+    };
+
+    dedup_sink::dedup_sink(writer write, options opts) :
+        write_(std::move(write)),
+        window_(opts.window),
+        now_(std::move(opts.now)),
+        sentinels_(std::move(opts.sentinels)),
+        shards_(new shard[std::max<std::size_t>(opts.shards, 1)]),
+        shardCount_(std::max<std::size_t>(opts.shards, 1))
+    {
+        if (!now_)
+            now_ = [] { return clock::now(); };
+
+        for (auto& sentinel : sentinels_)
+            sentinelPtrs_.push_back(sentinel.data().get());
+
+        std::sort(sentinelPtrs_.begin(), sentinelPtrs_.end());
+    }
+
+    dedup_sink::dedup_sink(std::ostream& os, options opts) :
+        dedup_sink([&os, mutex = std::make_shared<std::mutex>()](dedup_record const& record)
+        {
+            char prefix[32];
+            std::snprintf(prefix, sizeof(prefix), "[%016" PRIx64 "] ", record.fingerprint);
+
+            auto line = std::string(prefix);
+            if (record.repeats == 0)
+                line += record.err.message();
+            else
+                line += "repeated " + std::to_string(record.repeats) + " times";
+
+            line += '\n';
+
+            std::lock_guard<std::mutex> lock(*mutex);
+            os << line;
+        }, std::move(opts))
+    {}
+
+    dedup_sink::~dedup_sink()
+    {
+        flush();
+    }
+
+    auto dedup_sink::write(error const& err) -> bool
+    {
+        if (!err)
+            return false;
+
+        auto fp = fingerprint(err);
+        auto now = now_();
+        auto& s = shards_[fp % shardCount_];
+
+        pending_summary summary{{}, fp, 0};
+        {
+            std::lock_guard<std::mutex> lock(s.mutex);
+
+            auto [found, inserted] = s.windows.try_emplace(fp);
+            auto& window = found->second;
+
+            if (!inserted && now - window.start < window_)
+            {
+                window.repeats++;
+                return false;
+            }
+
+            if (window.repeats != 0)
+            {
+                summary.err = std::move(window.first);
+                summary.repeats = window.repeats;
+            }
+
+            window.start = now;
+            window.repeats = 0;
+            window.first = err;
+
+            if (inserted && s.windows.size() > sweep_threshold)
+            {
+                for (auto it = s.windows.begin(); it != s.windows.end();)
+                {
+                    if (it->second.repeats == 0 && now - it->second.start >= window_)
+                        it = s.windows.erase(it);
+                    else
+                        ++it;
+                }
+            }
+        }
+
+        // Formatting and writing happen outside of the lock
+        if (summary.repeats != 0)
+            write_({summary.err, summary.fingerprint, summary.repeats});
+
+        write_({err, fp, 0});
+        return true;
+    }
+
+    auto dedup_sink::flush() -> void
+    {
+        std::vector<pending_summary> summaries;
+        for (std::size_t i = 0; i < shardCount_; i++)
+        {
+            auto& s = shards_[i];
+            std::lock_guard<std::mutex> lock(s.mutex);
+
+            for (auto& [fp, window] : s.windows)
+            {
+                if (window.repeats != 0)
+                    summaries.push_back({std::move(window.first), fp, window.repeats});
+            }
+
+            s.windows.clear();
+        }
+
+        for (auto& summary : summaries)
+            write_({summary.err, summary.fingerprint, summary.repeats});
+    }
+
+    auto dedup_sink::fingerprint(error const& err) const -> std::uint64_t
+    {
+        if (!err)
+            return 0;
+
+        std::uint64_t h = 0xcbf29ce484222325ULL;
+        detail::wrapping_impl::walk(err, traversal_options{}, [&](error const& node)
+        {
+            auto data = node.data().get();
+
+            // Within a binary each type has a single type_info, so its address identifies the type
+            auto id = std::binary_search(sentinelPtrs_.begin(), sentinelPtrs_.end(), data)
+                ? reinterpret_cast<std::uintptr_t>(data)
+                : reinterpret_cast<std::uintptr_t>(&typeid(*data));
+
+            h = mix(h ^ id);
+            return false;
+        });
+
+        return h == 0 ? 1 : h;
+    }
+}
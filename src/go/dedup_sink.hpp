@@ -0,0 +1,119 @@
+#pragma once
+
+#include <go/error.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+namespace go
+{
+    /*! \addtogroup reporting
+     * @{
+     */
+
+    /// What a `go::dedup_sink` asks its writer to emit.
+    struct dedup_record
+    {
+        /// The first error of a window. For summaries, the error that opened the window.
+        error const& err;
+
+        /// Fingerprint shared by all the collapsed errors.
+        std::uint64_t fingerprint;
+
+        /// Zero for the first error of a window, otherwise the number of errors
+        /// collapsed in the window after the first one.
+        std::uint64_t repeats;
+    };
+
+    /// Tuning knobs of `go::dedup_sink`.
+    struct dedup_sink_options
+    {
+        /// How long repeats are collapsed after the first error.
+        std::chrono::nanoseconds window = std::chrono::seconds(1);
+
+        /// Number of independently locked shards.
+        std::size_t shards = 16;
+
+        /// Errors listed here are told apart by identity instead of type,
+        /// the same way `go::is_error` compares them.
+        std::vector<error> sentinels;
+
+        /// Source of the current time. Uses `std::chrono::steady_clock::now` when empty.
+        std::function<std::chrono::steady_clock::time_point()> now;
+    };
+
+    /// Sink that collapses repeats of the same error into a single line per time window.
+    /*!
+     * Errors are considered the same when they have the same fingerprint: the dynamic
+     * types of the errors in the tree in traversal order, with sentinels distinguished
+     * by identity. Computing it walks the tree but doesn't render any message, so
+     * repeats cost a few virtual calls and a hash table lookup.
+     *
+     * The first error with a fingerprint is passed to the writer right away. Repeats
+     * within the window are only counted, and a summary with the count is written
+     * when the next error with the fingerprint comes after the window, or on `flush`.
+     *
+     * The sink is thread-safe. Fingerprints are spread over independently locked
+     * shards, and the writer is called without holding any lock, so it must be
+     * thread-safe itself.
+     */
+    class dedup_sink
+    {
+    public:
+        /// Clock used to measure windows.
+        using clock = std::chrono::steady_clock;
+
+        /// Called for the first error of every window and for every summary.
+        using writer = std::function<void(dedup_record const& record)>;
+
+        /// Tuning knobs of the sink.
+        using options = dedup_sink_options;
+
+        /// Creates a sink that passes records to write.
+        explicit dedup_sink(writer write, options opts = {});
+
+        /// Creates a sink that writes records to os, one line each:
+        /*!
+         * ```
+         * [3f9a0c21d4e5b678] connecting to db: connection refused
+         * [3f9a0c21d4e5b678] repeated 5123 times
+         * ```
+         *
+         * The stream must outlive the sink.
+         */
+        explicit dedup_sink(std::ostream& os, options opts = {});
+
+        /// Writes pending summaries.
+        ~dedup_sink();
+
+        dedup_sink(dedup_sink const&) = delete;
+        dedup_sink& operator=(dedup_sink const&) = delete;
+
+        /// Writes err, or counts it if an error with the same fingerprint was written
+        /// within the window. Returns true if err was passed to the writer.
+        auto write(error const& err) -> bool;
+
+        /// Writes summaries of all windows that collapsed repeats and forgets them.
+        auto flush() -> void;
+
+        /// Returns the fingerprint of err. Empty errors have a fingerprint of zero.
+        auto fingerprint(error const& err) const -> std::uint64_t;
+
+    private:
+        struct shard;
+
+        writer write_;
+        std::chrono::nanoseconds window_;
+        std::function<clock::time_point()> now_;
+        std::vector<error> sentinels_;
+        std::vector<error_interface const*> sentinelPtrs_;
+        std::unique_ptr<shard[]> shards_;
+        std::size_t shardCount_;
+    };
+
+    /*! @} */
+}
@@ -0,0 +1,123 @@
+#include <go/dedup_sink.hpp>
+#include <go/error_chain.hpp>
+#include <go/error_code.hpp>
+#include <go/errorf.hpp>
+
+#include <boost/ut.hpp>
+using namespace boost::ut;
+
+#include <sstream>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+struct fake_clock
+{
+	std::shared_ptr<go::dedup_sink::clock::time_point> now =
+		std::make_shared<go::dedup_sink::clock::time_point>();
+
+	auto advance(std::chrono::nanoseconds d) -> void { *now += d; }
+
+	auto source() const -> std::function<go::dedup_sink::clock::time_point()>
+	{
+		return [now = now] { return *now; };
+	}
+};
+
+struct recorded
+{
+	std::string message;
+	std::uint64_t repeats;
+};
+
+int main()
+{
+	"dedup_sink"_test = [] {
+		should("repeats within the window are collapsed") = [] {
+			fake_clock clock;
+			std::vector<recorded> records;
+
+			go::dedup_sink::options opts;
+			opts.now = clock.source();
+			go::dedup_sink sink([&](go::dedup_record const& r) { records.push_back({r.err.message(), r.repeats}); }, opts);
+
+			expect(sink.write(go::errorf("upstream ", "a", " unavailable")));
+			expect(sink.write(go::errorf("upstream ", "b", " unavailable")) == false);
+			expect(sink.write(go::errorf("upstream ", "c", " unavailable")) == false);
+			expect(records.size() == 1_ul);
+
+			clock.advance(2s);
+			expect(sink.write(go::errorf("upstream ", "d", " unavailable")));
+
+			expect(records.size() == 3_ul);
+			expect(records[1].repeats == 2_ul);
+			expect(records[1].message == "upstream a unavailable");
+			expect(records[2].repeats == 0_ul);
+			expect(records[2].message == "upstream d unavailable");
+		};
+
+		should("different shapes are written separately") = [] {
+			std::size_t written = 0;
+			go::dedup_sink sink([&](go::dedup_record const&) { written++; });
+
+			auto root = go::errorf("refused");
+			sink.write(root);
+			sink.write(go::wrap_error(root, "connecting"));
+			sink.write(go::make_error<go::error_code>(std::make_error_code(std::errc::timed_out)));
+
+			expect(written == 3_ul);
+			expect(sink.fingerprint(root) != sink.fingerprint(go::wrap_error(root, "connecting")));
+			expect(sink.fingerprint(go::errorf("x")) == sink.fingerprint(go::errorf("y")));
+		};
+
+		should("sentinels are told apart by identity") = [] {
+			auto errNotFound = go::errorf("not found");
+			auto errDenied = go::errorf("denied");
+
+			go::dedup_sink::options opts;
+			opts.sentinels = {errNotFound, errDenied};
+			go::dedup_sink sink([](go::dedup_record const&) {}, opts);
+
+			expect(sink.fingerprint(go::wrap_error(errNotFound, "reading"))
+				!= sink.fingerprint(go::wrap_error(errDenied, "reading")));
+			expect(sink.fingerprint(go::wrap_error(errNotFound, "reading"))
+				== sink.fingerprint(go::wrap_error(errNotFound, "writing")));
+		};
+
+		should("flush writes pending summaries") = [] {
+			std::ostringstream os;
+			{
+				go::dedup_sink sink(os);
+				for (int i = 0; i < 5; i++)
+					sink.write(go::errorf("boom"));
+			}
+
+			auto out = os.str();
+			expect(out.find("] boom\n") != std::string::npos) << out;
+			expect(out.find("] repeated 4 times\n") != std::string::npos) << out;
+		};
+
+		should("concurrent writers count every error") = [] {
+			std::atomic<std::uint64_t> total{0};
+			{
+				go::dedup_sink sink([&](go::dedup_record const& r) { total += r.repeats == 0 ? 1 : r.repeats; });
+
+				std::vector<std::thread> threads;
+				for (int t = 0; t < 4; t++)
+				{
+					threads.emplace_back([&] {
+						for (int i = 0; i < 1000; i++)
+							sink.write(i % 2 ? go::errorf("odd") : go::wrap_error(go::errorf("even"), "ctx"));
+					});
+				}
+
+				for (auto& thread : threads)
+					thread.join();
+			}
+
+			expect(total.load() == 4000_ul);
+		};
+	};
+
+	return 0;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+/// \cond TEMPLATE_DETAILS
+namespace go::detail
+{
+
+    /// Returns the number of set bits in word.
+    inline auto popcount(std::uint64_t word) noexcept -> unsigned
+    {
+#if defined(_MSC_VER)
+        return static_cast<unsigned>(__popcnt64(word));
+#elif defined(__POPCNT__) || defined(__ARM_NEON)
+        return static_cast<unsigned>(__builtin_popcountll(word));
+#else
+        // Without a popcount instruction the builtin is a library call, while
+        // this compiles to a few instructions that vectorize in loops
+        word = word - ((word >> 1) & 0x5555555555555555ULL);
+        word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+        word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+        return static_cast<unsigned>((word * 0x0101010101010101ULL) >> 56);
+#endif
+    }
+
+    /// Returns the index of the lowest set bit in word, which must not be zero.
+    inline auto lowest_bit(std::uint64_t word) noexcept -> unsigned
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_ctzll(word));
+#endif
+    }
+
+}
+/// \endcond
@@ -0,0 +1,29 @@
+#include <go/detail/demangle.hpp>
+
+#if defined(__has_include)
+    #if __has_include(<cxxabi.h>)
+        #include <cxxabi.h>
+        #include <cstdlib>
+        #define GOERROR_HAS_CXXABI
+    #endif
+#endif
+
+namespace go::detail
+{
+
+    auto demangle(const char* name) -> std::string
+    {
+#if defined(GOERROR_HAS_CXXABI)
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+        if (status == 0 && demangled)
+        {
+            std::string result = demangled;
+            std::free(demangled);
+            return result;
+        }
+#endif
+        return name;
+    }
+
+}
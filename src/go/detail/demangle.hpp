@@ -0,0 +1,14 @@
+#pragma once
+
+#include <string>
+
+/// \cond TEMPLATE_DETAILS
+namespace go::detail
+{
+
+    /// \brief Returns a human readable form of a mangled symbol or type name,
+    /// or the name as-is if it can't be demangled.
+    auto demangle(const char* name) -> std::string;
+
+}
+/// \endcond
@@ -3,6 +3,11 @@
 namespace go
 {
 
+	namespace detail
+	{
+		const std::vector<error> empty_errors;
+	}
+
 	error error_interface::unwrap() const
 	{
 		return {};
@@ -10,8 +15,38 @@ namespace go
 
 	const std::vector<error>& error_interface::unwrap_multiple() const
 	{
-        static std::vector<error> dummy;
-		return dummy;
+		return detail::empty_errors;
+	}
+
+	error_span error_interface::unwrap_span() const
+	{
+		return unwrap_multiple();
+	}
+
+	namespace detail
+	{
+		unwrap_multiple_cache::~unwrap_multiple_cache()
+		{
+			delete cached_.load(std::memory_order_relaxed);
+		}
+
+		auto unwrap_multiple_cache::get(error_span errs) const -> std::vector<error> const&
+		{
+			if (errs.empty())
+				return empty_errors;
+
+			if (auto cached = cached_.load(std::memory_order_acquire))
+				return *cached;
+
+			// Concurrent first calls each copy, the first one to finish wins
+			auto copy = new std::vector<error>(errs.begin(), errs.end());
+			std::vector<error> const* expected = nullptr;
+			if (cached_.compare_exchange_strong(expected, copy, std::memory_order_acq_rel))
+				return *copy;
+
+			delete copy;
+			return *expected;
+		}
 	}
 
 }
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <atomic>
 #include <type_traits>
+#include <typeinfo>
 #include <string>
+#include <string_view>
 #include <memory>
 #include <vector>
 
@@ -9,9 +12,35 @@
 
 namespace go
 {
+	struct error_interface;
+
 	namespace detail
 	{
 		struct wrapping_impl;
+
+#if defined(GOERROR_ENABLE_LIVE_TRACKING)
+		struct live_access;
+
+		// Bookkeeping of go/live_errors.hpp embedded into every error data
+		struct live_hook
+		{
+			live_hook() = default;
+
+			// Copies of error data are not tracked
+			live_hook(live_hook const&) noexcept {}
+			auto operator=(live_hook const&) noexcept -> live_hook& { return *this; }
+
+			// Defined in live_errors.cpp
+			~live_hook();
+
+			live_hook* prev = nullptr;
+			live_hook* next = nullptr;
+			std::type_info const* type = nullptr;
+			std::size_t bytes = 0;
+			std::weak_ptr<error_interface> self;
+			int mode = 0;
+		};
+#endif
 	}
 	template <class Impl>
 	struct error_of;
@@ -20,17 +49,97 @@ namespace go
 
 	using error = error_of<error_interface>;
 
+    /// \cond TEMPLATE_DETAILS
+    namespace detail
+    {
+        // Defined in reclaim.cpp, refer to go/reclaim.hpp. Destroys the last
+        // reference to an error without recursing into the errors it wraps.
+        auto release_error(std::shared_ptr<error_interface> data) noexcept -> void;
+
+        // Defined in memoize.cpp, refer to go/memoize.hpp. Views the memoized message
+        // of data, or renders the message into buffer.
+        auto message_view(error_interface const* data, std::string& buffer) -> std::string_view;
+    } // namespace detail
+    /// \endcond
+
     /*! \addtogroup core Core
      * @{
      */
 
+    /// A read-only view of a contiguous range of errors, as returned by `unwrap_span`.
+    /*!
+     * A pointer and a size, like `std::span<const error>`, which C++17 doesn't have yet.
+     * Views into a `std::vector`, a `std::array` or a plain array.
+     */
+    class error_span
+    {
+    public:
+        /// Creates an empty view.
+        constexpr error_span() noexcept = default;
+
+        /// Views size errors starting at first.
+        constexpr error_span(error const* first, std::size_t size) noexcept :
+            data_(first), size_(size)
+        {}
+
+        /// Views the errors of a vector.
+        error_span(std::vector<error> const& errs) noexcept;
+
+        /// Pointer to the first error.
+        constexpr auto data() const noexcept -> error const* { return data_; }
+
+        /// Number of errors.
+        constexpr auto size() const noexcept -> std::size_t { return size_; }
+
+        /// True if there are no errors.
+        constexpr auto empty() const noexcept -> bool { return size_ == 0; }
+
+        /// Begin iterator.
+        constexpr auto begin() const noexcept -> error const* { return data_; }
+
+        /// End iterator.
+        auto end() const noexcept -> error const*;
+
+        /// Returns the error at index.
+        auto operator[](std::size_t index) const noexcept -> error const&;
+
+    private:
+        error const* data_ = nullptr;
+        std::size_t size_ = 0;
+    };
+
+    /// \cond TEMPLATE_DETAILS
+    namespace detail
+    {
+        /// Vector of the wrapped errors, copied from `unwrap_span` on first use, for
+        /// error data that keeps its errors elsewhere and still implements `unwrap_multiple`.
+        class unwrap_multiple_cache
+        {
+        public:
+            unwrap_multiple_cache() = default;
+
+            // The copy belongs to a single error instance
+            unwrap_multiple_cache(unwrap_multiple_cache const&) noexcept {}
+            auto operator=(unwrap_multiple_cache const&) -> unwrap_multiple_cache& = delete;
+
+            ~unwrap_multiple_cache();
+
+            /// Returns a vector of errs, which must be the same on every call. Thread safe.
+            auto get(error_span errs) const -> std::vector<error> const&;
+
+        private:
+            mutable std::atomic<std::vector<error> const*> cached_{nullptr};
+        };
+    } // namespace detail
+    /// \endcond
+
     /// Core error interface to be implemented by user-defined errors.
     /*!
      * The interface emulates interface for go's errors. The Error() method is
      * represented by the `message()` pure virtual method, which is named to be
      * consistent with the message() method of std::error_code.
      *
-     * As in go, the user can additionally implement either unwrap of unwrap_multiple
+     * As in go, the user can additionally implement either unwrap or unwrap_span (or unwrap_multiple)
      * methods to provide wrapping functionality. This can be used to provide nested
      * context to the error and allow user code to decide its execution based on the
      * inner error types. The `go::is_error` and `go::as_error` functions can be used
@@ -55,10 +164,32 @@ namespace go
 		/// Returns an array of wrapped errors.
         /*! For the `go::is_error` and `go::as_error` functions to use `unwrap_multiple`,
          * `unwrap` should return empty error.
+         *
+         * Kept for error types that store their errors in a `std::vector`. The library
+         * itself only calls `unwrap_span`, whose default implementation views the vector
+         * returned from here.
          */
 		virtual auto unwrap_multiple() const -> std::vector<error> const&;
 
+		/// Returns a view of the wrapped errors.
+        /*! Like `unwrap_multiple`, but lets errors keep their wrapped errors anywhere,
+         * for example in an inline array. The view must stay valid as long as the
+         * error is alive. The default implementation views `unwrap_multiple()`.
+         *
+         * User types that only override `unwrap_span` return an empty vector from
+         * `unwrap_multiple`, so code that inspects wrapped errors should use
+         * `unwrap_span`. Predefined types implement both.
+         */
+		virtual auto unwrap_span() const -> error_span;
+
 		virtual ~error_interface() noexcept = default;
+
+#if defined(GOERROR_ENABLE_LIVE_TRACKING)
+	private:
+		detail::live_hook live_;
+
+		friend struct detail::live_access;
+#endif
 	};
 
     /*! @} */
@@ -161,7 +292,34 @@ namespace go
 
 		error_of() = default;
 
-		~error_of() = default;
+		/// Releases the error data. The last reference is released through
+		/// `detail::release_error`, so that deep trees don't overflow the stack.
+		~error_of()
+		{
+			release(std::move(err_));
+		}
+
+		// Declared explicitly, as the user-declared destructor would
+		// otherwise turn moves into reference counted copies
+		error_of(error_of const&) = default;
+		error_of(error_of&&) noexcept = default;
+
+		auto operator=(error_of const& other) -> error_of&
+		{
+			// The old data is released last, as other may be owned by it
+			auto old = std::move(err_);
+			err_ = other.err_;
+			release(std::move(old));
+			return *this;
+		}
+
+		auto operator=(error_of&& other) noexcept -> error_of&
+		{
+			auto old = std::move(err_);
+			err_ = std::move(other.err_);
+			release(std::move(old));
+			return *this;
+		}
 
         /// Copy constructor.
 		template<
@@ -178,10 +336,9 @@ namespace go
 			class OtherImpl,
 			class = std::enable_if_t<std::is_base_of_v<Impl, OtherImpl>>
 		>
-		error_of(error_of<OtherImpl>&& err)
+		error_of(error_of<OtherImpl>&& err) noexcept
 		{
-			err_ = err.data();
-			err = {};
+			err_ = std::move(err.err_);
 		}
 
         /// Construct via existing error data instance.
@@ -206,6 +363,17 @@ namespace go
 			return err_->message();
 		}
 
+        /// \brief Returns a view of the error message. Messages memoized with
+        /// `go::memoized_message` are viewed in place, others are rendered into buffer.
+        /*!
+         * The view stays valid as long as both the error data and buffer are alive and
+         * buffer isn't modified.
+         */
+		auto message_view(std::string& buffer) const -> std::string_view
+		{
+			return detail::message_view(err_.get(), buffer);
+		}
+
         /// Returns error data instance.
 		auto data() const -> std::shared_ptr<Impl>
 		{
@@ -224,14 +392,16 @@ namespace go
 
         /// \brief Returns an array of wrapped errors or an empty array
         /// if error data doesn't implement unwrap_multiple.
-		auto unwrap_multiple() const -> std::vector<error> const&
-		{
-			static std::vector<error> empty{};
+		auto unwrap_multiple() const -> std::vector<error> const&;
 
+        /// \brief Returns a view of the wrapped errors or an empty view
+        /// if error data doesn't implement unwrap_span or unwrap_multiple.
+		auto unwrap_span() const -> error_span
+		{
 			if (!err_)
-				return empty;
+				return {};
 
-			return err_->unwrap_multiple();
+			return err_->unwrap_span();
 		}
 
         /// Operator overload to the error's data.
@@ -243,6 +413,13 @@ namespace go
 	private:
 		std::shared_ptr<Impl> err_;
 
+		static auto release(std::shared_ptr<Impl>&& data) noexcept -> void
+		{
+			// Shared data only loses a reference, which never destroys anything
+			if (data && data.use_count() == 1)
+				detail::release_error(std::move(data));
+		}
+
 		// TODO: Target&& -> class = has const and Target is ref, otherwise non-const rvalue is ok
 		template <class Target>
 		auto is(Target const& other) const -> bool
@@ -274,6 +451,9 @@ namespace go
 		// instead of is and as methods that lack safety checks present
 		// in these free functions
 		friend class detail::wrapping_impl;
+
+		template <class OtherImpl>
+		friend struct error_of;
 	};
 
     /// Main error type. Expected to be returned from functions and used most of the time.
@@ -286,13 +466,84 @@ namespace go
     /// \cond TEMPLATE_DETAILS
     namespace detail
     {
+        /// Returned for errors without wrapped errors. Defined in error.cpp at namespace
+        /// scope, so that reading it needs no initialization guard.
+        extern const std::vector<error> empty_errors;
+    } // namespace detail
+    /// \endcond
+
+    inline error_span::error_span(std::vector<error> const& errs) noexcept :
+        data_(errs.data()), size_(errs.size())
+    {}
+
+    inline auto error_span::end() const noexcept -> error const*
+    {
+        return data_ + size_;
+    }
+
+    inline auto error_span::operator[](std::size_t index) const noexcept -> error const&
+    {
+        return data_[index];
+    }
+
+	template <class Impl>
+	auto error_of<Impl>::unwrap_multiple() const -> std::vector<error> const&
+	{
+		if (!err_)
+			return detail::empty_errors;
+
+		return err_->unwrap_multiple();
+	}
+
+    /// \cond TEMPLATE_DETAILS
+    namespace detail
+    {
+#if defined(GOERROR_ENABLE_METRICS)
+        // Defined in metrics.cpp, refer to go/metrics.hpp
+        auto metrics_register_type(std::type_info const& type) -> std::size_t;
+        auto metrics_count_creation(std::size_t slot) noexcept -> void;
+        auto metrics_count_traversal(std::size_t depth, std::size_t nodes) noexcept -> void;
+#endif
+
+#if defined(GOERROR_ENABLE_LIVE_TRACKING)
+        // Defined in live_errors.cpp, refer to go/live_errors.hpp
+        auto live_track(live_hook& hook, std::weak_ptr<error_interface> self,
+            std::type_info const& type, std::size_t bytes) -> void;
+
+        struct live_access
+        {
+            static auto hook(error_interface& err) -> live_hook&
+            {
+                return err.live_;
+            }
+        };
+#endif
+
+        /// Instrumentation hook called whenever an error of type Impl is created
+        /// by the library. node is the allocated error data, if the error has its own
+        /// allocation. Compiles to nothing unless instrumentation is enabled.
+        template <class Impl, class Node = Impl>
+        inline auto on_error_created(std::shared_ptr<Node> const& node = {}) -> void
+        {
+#if defined(GOERROR_ENABLE_METRICS)
+            static const std::size_t slot = metrics_register_type(typeid(Impl));
+            metrics_count_creation(slot);
+#endif
+#if defined(GOERROR_ENABLE_LIVE_TRACKING)
+            // Approximated by the size of the error data and the reference counts
+            if (node)
+                live_track(live_access::hook(*node), node, typeid(Impl), sizeof(Node) + 2 * sizeof(long));
+#endif
+            (void)node;
+        }
+
         template <class ErrorType>
         struct make_error_impl
         {
             template <class... Args>
             static auto make(Args&&... args) -> ErrorType
             {
-                static_assert(always_false<ErrorType>, "ErrorType should a valid go::error_of<T>");
+                static_assert(always_false<ErrorType>::value, "ErrorType should a valid go::error_of<T>");
             }
         };
 
@@ -303,6 +554,8 @@ namespace go
             static auto make(Args&&... args) -> error_of<Impl>
             {
                 auto impl = std::make_shared<Impl>(std::forward<Args>(args)...);
+                on_error_created<Impl>(impl);
+
                 return error_of<Impl>(std::move(impl));
             }
         };
@@ -333,7 +586,8 @@ namespace go
 template <class A, class B>
 auto operator==(go::error_of<A> const& a, go::error_of<B> const& b) -> bool
 {
-	return a.data().get() == b.data().get();
+	// Compared without copying the shared pointers, which would touch the reference counts
+	return static_cast<go::error_interface const*>(a.operator->()) == static_cast<go::error_interface const*>(b.operator->());
 }
 
 /// Refer to `operator==`
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <go/error.hpp>
+#include <go/hash.hpp>
+#include <go/memoize.hpp>
+#include <go/render.hpp>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace go
+{
+    /// \cond TEMPLATE_DETAILS
+    namespace detail
+    {
+        struct error_chain_block;
+    }
+    /// \endcond
+
+    auto wrap_error(error err, std::string context) -> error;
+
+    /*! \addtogroup predefined Predefined errors
+     * @{
+     */
+
+    /// Error data for a single context frame created by `go::wrap_error`.
+    /*!
+     * Frames of the same chain live next to each other in a single block owned by
+     * the chain, so wrapping doesn't allocate a separate node per context. Each frame
+     * still unwraps to the previous frame, and the first frame unwraps to the error
+     * the chain was started from, so `go::is_error` and `go::as_error` see an ordinary
+     * unwrap chain.
+     *
+     * The message of a frame is its context followed by a colon and the message of
+     * the wrapped error. Frames never change, so the message is rendered once.
+     */
+    struct error_frame_data : public error_interface, public hashable_interface, public memoized_message,
+        public composite_message_interface
+    {
+        /// Move constructor, used when the chain's block grows.
+        error_frame_data(error_frame_data&&) noexcept = default;
+
+        /// Returns the context string this frame was created with.
+        auto context() const -> std::string const&
+        {
+            return context_;
+        }
+
+        /// Returns context of the frame followed by the wrapped error's message.
+        auto message() const -> std::string override
+        {
+            return std::string(message_view());
+        }
+
+        /// Returns the previous frame of the chain or the error the chain started from.
+        auto unwrap() const -> error override;
+
+        /// The context and a colon before the wrapped error's message.
+        auto message_layout() const -> go::message_layout override
+        {
+            return {context_ + ": ", {}, {}, {}, {}};
+        }
+
+        /// Hashes the context string.
+        auto hash() const noexcept -> std::size_t override
+        {
+            return std::hash<std::string_view>()(context_);
+        }
+
+        /// Compares the context strings.
+        auto equals(error_interface const& other) const noexcept -> bool override
+        {
+            return context_ == static_cast<error_frame_data const&>(other).context_;
+        }
+
+    protected:
+        /// Frames never change once pushed, so the hash of a chain is computed once
+        /// unless the error at its root may change.
+        auto tree_hash_cacheable() const noexcept -> bool override
+        {
+            return true;
+        }
+
+        auto render_message() const -> std::string override;
+
+    private:
+        error_frame_data(std::string context, detail::error_chain_block* block, std::size_t index) :
+            context_(std::move(context)), block_(block), index_(index)
+        {}
+
+        std::string context_;
+        detail::error_chain_block* block_;
+        std::size_t index_;
+
+        friend struct detail::error_chain_block;
+        friend auto wrap_error(error err, std::string context) -> error;
+    };
+
+    /// An error that adds a context string to another error, as created by `go::wrap_error`.
+    /*!
+     * Refer to `go::error_frame_data` for behavior details.
+     */
+    using error_frame = error_of<error_frame_data>;
+
+    /*! @} */
+
+    /// \cond TEMPLATE_DETAILS
+    namespace detail
+    {
+        /// Growable storage for the frames of a single wrap chain.
+        struct error_chain_block : public std::enable_shared_from_this<error_chain_block>
+        {
+            /// Enough for the usual depth of a call stack, so that a chain needs
+            /// one allocation for the block and one for the frames.
+            static constexpr std::size_t initial_capacity = 16;
+
+            error root;
+            std::vector<error_frame_data> frames;
+
+            /// Appends a frame and returns it as an error sharing ownership of the block.
+            static auto push(std::shared_ptr<error_chain_block> block, std::string context) -> error
+            {
+                auto index = block->frames.size();
+                block->frames.push_back(error_frame_data(std::move(context), block.get(), index));
+
+                error_interface* top = &block->frames.back();
+                return error(std::shared_ptr<error_interface>(std::move(block), top));
+            }
+
+            /// Returns the frame at index as an error sharing ownership of the block.
+            auto frame(std::size_t index) -> error
+            {
+                return error(std::shared_ptr<error_interface>(shared_from_this(), &frames[index]));
+            }
+        };
+    } // namespace detail
+    /// \endcond
+
+    inline auto error_frame_data::render_message() const -> std::string
+    {
+        std::string msg = context_;
+        msg += ": ";
+        append_message(msg, unwrap());
+        return msg;
+    }
+
+    inline auto error_frame_data::unwrap() const -> error
+    {
+        if (index_ == 0)
+            return block_->root;
+
+        return block_->frame(index_ - 1);
+    }
+
+    /*! \addtogroup wrapping
+     * @{
+     */
+
+    /// Wraps err with a context string and returns the resulting `go::error_frame`.
+    /*!
+     * When err is itself a frame of a chain and the passed error is the only reference
+     * to that chain, the new frame is appended in place into the chain's block instead
+     * of allocating a new node. Pass the error by moving it to make use of that:
+     *
+     * ```
+     * err = go::wrap_error(std::move(err), "loading config");
+     * ```
+     *
+     * If any other reference to the chain is alive, a new chain is started on top
+     * of err, so existing errors are never modified.
+     *
+     * Wrapping an empty error returns an empty error.
+     */
+    inline auto wrap_error(error err, std::string context) -> error
+    {
+        if (!err)
+            return {};
+
+        detail::on_error_created<error_frame_data>();
+
+        auto data = err.data();
+        err = {};
+
+        // Only our reference to the chain is left, so nobody can observe the frames
+        // above this one, and the block can be reused
+        auto frame = dynamic_cast<error_frame_data*>(data.get());
+        if (frame && data.use_count() == 1)
+        {
+            auto block = std::shared_ptr<detail::error_chain_block>(std::move(data), frame->block_);
+            while (block->frames.size() > frame->index_ + 1)
+                block->frames.pop_back();
+
+            return detail::error_chain_block::push(std::move(block), std::move(context));
+        }
+
+        auto block = std::make_shared<detail::error_chain_block>();
+        block->root = error(std::move(data));
+        block->frames.reserve(detail::error_chain_block::initial_capacity);
+
+        return detail::error_chain_block::push(std::move(block), std::move(context));
+    }
+
+    /*! @} */
+}
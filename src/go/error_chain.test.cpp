@@ -0,0 +1,125 @@
+#include <go/error_chain.hpp>
+#include <go/error_code.hpp>
+#include <go/errorf.hpp>
+#include <go/wrap.hpp>
+
+#include <boost/ut.hpp>
+using namespace boost::ut;
+
+#include <cstdlib>
+#include <new>
+
+static std::size_t allocationCount = 0;
+
+void* operator new(std::size_t size)
+{
+	allocationCount++;
+
+	if (auto ptr = std::malloc(size ? size : 1))
+		return ptr;
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+int main()
+{
+	"wrap_error"_test = [] {
+		should("wrapping an empty error returns an empty error") = [] {
+			auto err = go::wrap_error(go::error(), "context");
+
+			expect(err == false);
+		};
+
+		should("message is the context followed by the wrapped message") = [] {
+			auto err = go::wrap_error(go::errorf("boom"), "reading");
+			err = go::wrap_error(std::move(err), "loading config");
+
+			expect(err.message() == "loading config: reading: boom") << "got" << err.message();
+		};
+
+		should("frames unwrap to the previous frame and then to the root") = [] {
+			auto root = go::errorf("root");
+
+			auto err = go::wrap_error(root, "a");
+			err = go::wrap_error(std::move(err), "b");
+			err = go::wrap_error(std::move(err), "c");
+
+			auto b = err.unwrap();
+			auto a = b.unwrap();
+
+			expect(b.message() == "b: a: root") << "got" << b.message();
+			expect(a.message() == "a: root") << "got" << a.message();
+			expect(a.unwrap() == root);
+			expect(go::error_cast<go::error_frame>(a)->context() == "a");
+		};
+
+		should("is_error and as_error see through the chain") = [] {
+			auto ec = std::make_error_code(std::errc::timed_out);
+			auto root = go::make_error<go::error_code>(ec);
+
+			go::error err = root;
+			for (int i = 0; i < 10; i++)
+				err = go::wrap_error(std::move(err), "layer " + std::to_string(i));
+
+			expect(go::is_error(err, root));
+
+			go::error_code target;
+			expect(go::as_error(err, target));
+			expect(target == root);
+
+			go::error_frame frame;
+			expect(go::as_error(err, frame));
+			expect(frame->context() == "layer 9") << "got" << frame->context();
+		};
+
+		should("wrapping a shared chain leaves the original untouched") = [] {
+			auto base = go::wrap_error(go::errorf("root"), "base");
+
+			auto left = go::wrap_error(base, "left");
+			auto right = go::wrap_error(base, "right");
+
+			expect(base.message() == "base: root") << "got" << base.message();
+			expect(left.message() == "left: base: root") << "got" << left.message();
+			expect(right.message() == "right: base: root") << "got" << right.message();
+			expect(left.unwrap() == base);
+			expect(right.unwrap() == base);
+		};
+
+		should("a uniquely owned inner frame drops the unreachable frames above it") = [] {
+			auto err = go::wrap_error(go::errorf("root"), "a");
+			err = go::wrap_error(std::move(err), "b");
+
+			auto a = err.unwrap();
+			err = {};
+
+			auto c = go::wrap_error(std::move(a), "c");
+
+			expect(c.message() == "c: a: root") << "got" << c.message();
+		};
+
+		should("a 10 frame chain costs at most two allocations") = [] {
+			auto root = go::errorf("root");
+
+			auto before = allocationCount;
+
+			go::error err = root;
+			for (int i = 0; i < 10; i++)
+				err = go::wrap_error(std::move(err), "short ctx");
+
+			auto allocations = allocationCount - before;
+			expect(allocations <= 2) << "got" << allocations << "allocations, want at most 2";
+		};
+	};
+
+	return 0;
+}
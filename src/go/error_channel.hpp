@@ -0,0 +1,161 @@
+#pragma once
+
+#include <go/error.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace go
+{
+    /*! \addtogroup reporting Reporting
+     * @{
+     */
+
+    /// Bounded lock-free queue that hands errors from many threads to a single consumer.
+    /*!
+     * Producers never block: when the queue is full the error is dropped and counted.
+     * Errors are moved into and out of the queue, so passing them through doesn't touch
+     * their reference counts.
+     *
+     * `try_push` may be called from any number of threads. `try_pop` and `drain`
+     * must only be called from one thread at a time.
+     *
+     * ```
+     * go::error_channel channel(4096);
+     *
+     * // Worker threads
+     * channel.try_push(std::move(err));
+     *
+     * // Reporter thread
+     * channel.drain([&](go::error&& err) { log(err); });
+     * ```
+     */
+    class error_channel
+    {
+    public:
+        /// Creates an empty queue. The capacity is rounded up to a power of two.
+        explicit error_channel(std::size_t capacity) :
+            mask_(round_up(capacity) - 1),
+            slots_(new slot[mask_ + 1])
+        {
+            for (std::size_t i = 0; i <= mask_; i++)
+                slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        error_channel(error_channel const&) = delete;
+        error_channel& operator=(error_channel const&) = delete;
+
+        /// Moves err into the queue. Returns false and counts a drop if the queue is full,
+        /// err is left untouched in that case.
+        auto try_push(error&& err) noexcept -> bool
+        {
+            auto pos = tail_.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                auto& cell = slots_[pos & mask_];
+                auto sequence = cell.sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+
+                if (diff == 0)
+                {
+                    if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        cell.err = std::move(err);
+                        cell.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                else
+                {
+                    pos = tail_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /// Moves the oldest error into err. Returns false if the queue is empty.
+        auto try_pop(error& err) noexcept -> bool
+        {
+            auto& cell = slots_[head_ & mask_];
+            auto sequence = cell.sequence.load(std::memory_order_acquire);
+            if (sequence != head_ + 1)
+                return false;
+
+            err = std::move(cell.err);
+            cell.sequence.store(head_ + mask_ + 1, std::memory_order_release);
+            head_++;
+            return true;
+        }
+
+        /// Calls f with up to max errors that are in the queue, oldest first,
+        /// and returns how many were passed.
+        template <class F>
+        auto drain(F&& f, std::size_t max = std::numeric_limits<std::size_t>::max()) -> std::size_t
+        {
+            std::size_t count = 0;
+            error err;
+            while (count < max && try_pop(err))
+            {
+                f(std::move(err));
+                count++;
+            }
+
+            return count;
+        }
+
+        /// Appends up to max errors that are in the queue to out and returns how many were appended.
+        auto drain(std::vector<error>& out, std::size_t max = std::numeric_limits<std::size_t>::max()) -> std::size_t
+        {
+            return drain([&](error&& err) { out.push_back(std::move(err)); }, max);
+        }
+
+        /// Returns how many errors were dropped because the queue was full.
+        auto dropped() const noexcept -> std::uint64_t
+        {
+            return dropped_.load(std::memory_order_relaxed);
+        }
+
+        /// Returns the maximum number of errors the queue holds.
+        auto capacity() const noexcept -> std::size_t
+        {
+            return mask_ + 1;
+        }
+
+    private:
+        // Each slot's sequence tells whose turn it is: equal to the position
+        // when a producer may fill it, one past it when the consumer may take it.
+        // Slots take a cache line each, so that neighbouring slots don't contend.
+        struct alignas(64) slot
+        {
+            std::atomic<std::size_t> sequence;
+            error err;
+        };
+
+        static auto round_up(std::size_t capacity) -> std::size_t
+        {
+            std::size_t size = 2;
+            while (size < capacity)
+                size *= 2;
+
+            return size;
+        }
+
+        std::size_t mask_;
+        std::unique_ptr<slot[]> slots_;
+
+        // Producers and the consumer touch different cache lines
+        alignas(64) std::atomic<std::size_t> tail_{0};
+        alignas(64) std::atomic<std::uint64_t> dropped_{0};
+        alignas(64) std::size_t head_ = 0;
+    };
+
+    /*! @} */
+}
@@ -0,0 +1,106 @@
+#include <go/error_channel.hpp>
+#include <go/errorf.hpp>
+
+#include <boost/ut.hpp>
+using namespace boost::ut;
+
+#include <thread>
+
+int main()
+{
+	"error_channel"_test = [] {
+		should("errors come out in order") = [] {
+			go::error_channel channel(8);
+
+			auto a = go::errorf("a");
+			auto b = go::errorf("b");
+			expect(channel.try_push(go::error(a)));
+			expect(channel.try_push(go::error(b)));
+
+			go::error err;
+			expect(channel.try_pop(err));
+			expect(err == a);
+			expect(channel.try_pop(err));
+			expect(err == b);
+			expect(channel.try_pop(err) == false);
+		};
+
+		should("full queue drops and counts") = [] {
+			go::error_channel channel(3);
+			expect(channel.capacity() == 4_ul);
+
+			for (int i = 0; i < 4; i++)
+				expect(channel.try_push(go::errorf(i)));
+
+			auto err = go::errorf("dropped");
+			expect(channel.try_push(std::move(err)) == false);
+			expect(err == true) << "dropped error should stay with the caller";
+			expect(channel.dropped() == 1_ul);
+
+			std::vector<go::error> batch;
+			expect(channel.drain(batch, 3) == 3_ul);
+			expect(batch[0].message() == "0");
+			expect(channel.try_push(go::errorf("fits again")));
+		};
+
+		should("pushing moves the handle") = [] {
+			go::error_channel channel(2);
+
+			auto err = go::errorf("moved");
+			auto data = err.data().get();
+			channel.try_push(std::move(err));
+
+			expect(err == false);
+
+			go::error out;
+			channel.try_pop(out);
+			expect(out.data().get() == data);
+			expect(out.data().use_count() == 2_l) << "only out and the copy returned by data()";
+		};
+
+		should("concurrent producers lose nothing but drops") = [] {
+			constexpr int producers = 4;
+			constexpr int perProducer = 20000;
+
+			go::error_channel channel(256);
+			auto err = go::errorf("shared");
+
+			std::vector<std::thread> threads;
+			std::atomic<int> pushed{0};
+			for (int t = 0; t < producers; t++)
+			{
+				threads.emplace_back([&] {
+					for (int i = 0; i < perProducer; i++)
+					{
+						if (channel.try_push(go::error(err)))
+							pushed++;
+					}
+				});
+			}
+
+			std::size_t received = 0;
+			bool allSame = true;
+			auto consume = [&] {
+				return channel.drain([&](go::error&& e) {
+					allSame = allSame && e == err;
+					received++;
+				});
+			};
+
+			for (auto& thread : threads)
+			{
+				while (consume() != 0) {}
+				thread.join();
+			}
+
+			consume();
+
+			expect(allSame);
+			expect(received == static_cast<std::size_t>(pushed.load()));
+			expect(received + channel.dropped() == std::size_t(producers) * perProducer);
+			expect(err.data().use_count() == 2_l) << "only err and the copy returned by data()";
+		};
+	};
+
+	return 0;
+}
@@ -17,6 +17,8 @@ namespace go
      *
      * Additionally, helper methods provide a more convenient access
      * to `std::error_code`'s members.
+     *
+     * `go::error_hash` and `go::error_value_equal` compare it by its error code.
      */
     struct error_code_data : public error_interface
     {
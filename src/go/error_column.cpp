@@ -0,0 +1,179 @@
+#include <go/error_column.hpp>
+#include <go/multi_error.hpp>
+#include <go/detail/bits.hpp>
+
+#include <algorithm>
+
+namespace go
+{
+    namespace
+    {
+        auto by_row(std::pair<std::size_t, error> const& entry, std::size_t row) -> bool
+        {
+            return entry.first < row;
+        }
+    }
+
+    error_column::error_column(std::size_t rows) :
+        rows_(rows), bits_((rows + word_bits - 1) / word_bits)
+    {}
+
+    auto error_column::resize(std::size_t rows) -> void
+    {
+        if (rows < rows_)
+        {
+            errors_.erase(std::lower_bound(errors_.begin(), errors_.end(), rows, by_row), errors_.end());
+
+            // Bits past the last row must stay clear for the word scans
+            if (rows % word_bits != 0)
+                bits_[rows / word_bits] &= (std::uint64_t(1) << (rows % word_bits)) - 1;
+        }
+
+        rows_ = rows;
+        bits_.resize((rows + word_bits - 1) / word_bits);
+    }
+
+    auto error_column::clear() noexcept -> void
+    {
+        std::fill(bits_.begin(), bits_.end(), 0);
+        errors_.clear();
+    }
+
+    auto error_column::set(std::size_t row, error err) -> void
+    {
+        auto& word = bits_[row / word_bits];
+        auto bit = std::uint64_t(1) << (row % word_bits);
+
+        // Rows are usually filled in order, which only appends
+        if (err && !(word & bit) && (errors_.empty() || errors_.back().first < row))
+        {
+            word |= bit;
+            errors_.emplace_back(row, std::move(err));
+            return;
+        }
+
+        auto it = std::lower_bound(errors_.begin(), errors_.end(), row, by_row);
+        auto found = it != errors_.end() && it->first == row;
+
+        if (!err)
+        {
+            if (found)
+                errors_.erase(it);
+
+            word &= ~bit;
+        }
+        else if (found)
+        {
+            it->second = std::move(err);
+        }
+        else
+        {
+            errors_.emplace(it, row, std::move(err));
+            word |= bit;
+        }
+    }
+
+    auto error_column::get(std::size_t row) const -> error
+    {
+        if (!is_error(row))
+            return {};
+
+        return std::lower_bound(errors_.begin(), errors_.end(), row, by_row)->second;
+    }
+
+    auto error_column::masked_word(std::size_t index, std::size_t first, std::size_t last) const noexcept -> std::uint64_t
+    {
+        auto word = bits_[index];
+        if (index == first / word_bits)
+            word &= ~std::uint64_t(0) << (first % word_bits);
+        if (index == (last - 1) / word_bits && last % word_bits != 0)
+            word &= (std::uint64_t(1) << (last % word_bits)) - 1;
+
+        return word;
+    }
+
+    auto error_column::any(std::size_t first, std::size_t last) const noexcept -> bool
+    {
+        last = std::min(last, rows_);
+        if (first >= last)
+            return false;
+
+        auto firstWord = first / word_bits;
+        auto lastWord = (last - 1) / word_bits;
+        if (masked_word(firstWord, first, last) != 0 || masked_word(lastWord, first, last) != 0)
+            return true;
+
+        // Branch-free blocks of whole words, which compilers turn into vector ORs
+        auto i = firstWord + 1;
+        for (; i + block_words <= lastWord; i += block_words)
+        {
+            std::uint64_t block = 0;
+            for (std::size_t j = 0; j < block_words; j++)
+                block |= bits_[i + j];
+
+            if (block != 0)
+                return true;
+        }
+
+        for (; i < lastWord; i++)
+        {
+            if (bits_[i] != 0)
+                return true;
+        }
+
+        return false;
+    }
+
+    auto error_column::count(std::size_t first, std::size_t last) const noexcept -> std::size_t
+    {
+        last = std::min(last, rows_);
+        if (first >= last)
+            return 0;
+
+        auto firstWord = first / word_bits;
+        auto lastWord = (last - 1) / word_bits;
+
+        std::size_t total = detail::popcount(masked_word(firstWord, first, last));
+        if (lastWord == firstWord)
+            return total;
+
+        for (auto i = firstWord + 1; i < lastWord; i++)
+            total += detail::popcount(bits_[i]);
+
+        return total + detail::popcount(masked_word(lastWord, first, last));
+    }
+
+    auto error_column::first_error(std::size_t from) const noexcept -> std::size_t
+    {
+        if (from >= rows_)
+            return npos;
+
+        auto index = from / word_bits;
+        auto word = masked_word(index, from, rows_);
+        auto lastWord = (rows_ - 1) / word_bits;
+
+        while (word == 0)
+        {
+            if (++index > lastWord)
+                return npos;
+
+            word = bits_[index];
+        }
+
+        return index * word_bits + detail::lowest_bit(word);
+    }
+
+    auto error_column::to_multi_error() const -> error
+    {
+        if (errors_.empty())
+            return {};
+
+        std::vector<error> rows;
+        rows.reserve(errors_.size());
+
+        for (auto& [row, err] : errors_)
+            rows.push_back(make_error<error_row>(row, err));
+
+        return make_error<error_multi>(std::move(rows));
+    }
+}
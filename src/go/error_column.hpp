@@ -0,0 +1,185 @@
+#pragma once
+
+#include <go/error.hpp>
+#include <go/hash.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace go
+{
+    /*! \addtogroup predefined Predefined errors
+     * @{
+     */
+
+    /// Error data for `go::error_row`, an error of a single row of a `go::error_column`.
+    /*!
+     * The message is the row number followed by the message of the wrapped error:
+     *
+     * ```
+     * row 1042: port is out of range
+     * ```
+     */
+    struct error_row_data : public error_interface, public hashable_interface
+    {
+        /// Wraps the error of row.
+        error_row_data(std::size_t row, error err) :
+            row_(row), err_(std::move(err))
+        {}
+
+        /// Returns the row the error belongs to.
+        auto row() const -> std::size_t
+        {
+            return row_;
+        }
+
+        /// Returns the row number followed by the wrapped error's message.
+        auto message() const -> std::string override
+        {
+            return "row " + std::to_string(row_) + ": " + err_.message();
+        }
+
+        /// Returns the error of the row.
+        auto unwrap() const -> error override
+        {
+            return err_;
+        }
+
+        /// Hashes the row number.
+        auto hash() const noexcept -> std::size_t override
+        {
+            return std::hash<std::size_t>()(row_);
+        }
+
+        /// Compares the row numbers.
+        auto equals(error_interface const& other) const noexcept -> bool override
+        {
+            return row_ == static_cast<error_row_data const&>(other).row_;
+        }
+
+    protected:
+        auto tree_hash_cacheable() const noexcept -> bool override
+        {
+            return true;
+        }
+
+    private:
+        std::size_t row_;
+        error err_;
+    };
+
+    /// An error of a single row, as created by `go::error_column::to_multi_error`.
+    using error_row = error_of<error_row_data>;
+
+    /*! @} */
+
+    /*! \addtogroup reporting
+     * @{
+     */
+
+    /// Errors of a batch of rows, stored by columns.
+    /*!
+     * Most rows of a batch are usually fine, so instead of an error per row the column
+     * keeps a bitmap with a bit per row and a side table of the errors of failed rows,
+     * sorted by row. A fine row costs a single bit, and questions about the whole
+     * batch or a range of rows are answered from the bitmap 64 rows at a time, without
+     * touching any error.
+     *
+     * ```
+     * go::error_column errs(batch.size());
+     * for (std::size_t row = 0; row < batch.size(); row++)
+     *     errs.set(row, validate(batch[row]));
+     *
+     * if (errs.any())
+     *     return errs.to_multi_error();
+     * ```
+     *
+     * Setting errors in increasing row order appends to the side table. Other orders
+     * insert into it, which moves the errors of later rows. As with `std::vector`,
+     * rows passed to the accessors must be less than `size()`.
+     */
+    class error_column
+    {
+    public:
+        /// Returned by `first_error` when no row has an error.
+        static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+        /// Creates an empty column without rows.
+        error_column() = default;
+
+        /// Creates a column of rows without errors.
+        explicit error_column(std::size_t rows);
+
+        /// Returns the number of rows.
+        auto size() const noexcept -> std::size_t
+        {
+            return rows_;
+        }
+
+        /// Changes the number of rows. Errors of removed rows are dropped and added rows have no error.
+        auto resize(std::size_t rows) -> void;
+
+        /// Removes all errors, keeping the number of rows.
+        auto clear() noexcept -> void;
+
+        /// Sets the error of row. Setting an empty error marks the row as fine.
+        auto set(std::size_t row, error err) -> void;
+
+        /// Returns the error of row, or an empty error if the row is fine.
+        auto get(std::size_t row) const -> error;
+
+        /// Returns true if row has an error.
+        auto is_error(std::size_t row) const noexcept -> bool
+        {
+            return (bits_[row / word_bits] >> (row % word_bits)) & 1;
+        }
+
+        /// Returns true if any row has an error.
+        auto any() const noexcept -> bool
+        {
+            return !errors_.empty();
+        }
+
+        /// Returns true if any row in [first, last) has an error.
+        auto any(std::size_t first, std::size_t last) const noexcept -> bool;
+
+        /// Returns the number of rows with an error.
+        auto count() const noexcept -> std::size_t
+        {
+            return errors_.size();
+        }
+
+        /// Returns the number of rows in [first, last) with an error.
+        auto count(std::size_t first, std::size_t last) const noexcept -> std::size_t;
+
+        /// Returns the first row at or after from that has an error, or npos.
+        auto first_error(std::size_t from = 0) const noexcept -> std::size_t;
+
+        /// Returns the rows with errors and their errors, sorted by row.
+        auto errors() const noexcept -> std::vector<std::pair<std::size_t, error>> const&
+        {
+            return errors_;
+        }
+
+        /// Returns an `go::error_multi` of a `go::error_row` per failed row, or an
+        /// empty error if all rows are fine.
+        auto to_multi_error() const -> error;
+
+    private:
+        static constexpr std::size_t word_bits = 64;
+        static constexpr std::size_t block_words = 8;
+
+        // Bitmap word at index with the bits outside of [first, last) cleared
+        auto masked_word(std::size_t index, std::size_t first, std::size_t last) const noexcept -> std::uint64_t;
+
+        std::size_t rows_ = 0;
+        std::vector<std::uint64_t> bits_;
+        std::vector<std::pair<std::size_t, error>> errors_;
+    };
+
+    /*! @} */
+}
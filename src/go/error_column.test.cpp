@@ -0,0 +1,109 @@
+#include <go/error_column.hpp>
+#include <go/errorf.hpp>
+#include <go/wrap.hpp>
+
+#include <boost/ut.hpp>
+using namespace boost::ut;
+
+int main()
+{
+	"error_column"_test = [] {
+		should("rows without errors are fine") = [] {
+			go::error_column errs(1000);
+
+			expect(errs.size() == 1000_ul);
+			expect(errs.any() == false);
+			expect(errs.count() == 0_ul);
+			expect(errs.first_error() == go::error_column::npos);
+			expect(errs.get(10) == false);
+			expect(errs.to_multi_error() == false);
+		};
+
+		should("errors are found by row") = [] {
+			auto errInvalid = go::errorf("invalid");
+			go::error_column errs(1000);
+
+			errs.set(70, errInvalid);
+			errs.set(999, go::errorf("last"));
+			errs.set(3, go::errorf("first"));
+
+			expect(errs.count() == 3_ul);
+			expect(errs.is_error(70));
+			expect(errs.is_error(71) == false);
+			expect(errs.get(70) == errInvalid);
+			expect(errs.get(3).message() == "first");
+
+			expect(errs.first_error() == 3_ul);
+			expect(errs.first_error(4) == 70_ul);
+			expect(errs.first_error(71) == 999_ul);
+
+			expect(errs.errors().front().first == 3_ul);
+			expect(errs.errors().back().first == 999_ul);
+		};
+
+		should("ranges are scanned over the bitmap") = [] {
+			go::error_column errs(2000);
+			errs.set(5, go::errorf("a"));
+			errs.set(64, go::errorf("b"));
+			errs.set(1500, go::errorf("c"));
+
+			expect(errs.any(6, 64) == false);
+			expect(errs.any(6, 65));
+			expect(errs.any(65, 1500) == false);
+			expect(errs.any(0, 2000));
+			expect(errs.any(1000, 5000));
+			expect(errs.count(0, 2000) == 3_ul);
+			expect(errs.count(5, 65) == 2_ul);
+			expect(errs.count(6, 64) == 0_ul);
+			expect(errs.count(1499, 1501) == 1_ul);
+		};
+
+		should("empty errors clear rows") = [] {
+			go::error_column errs(100);
+			errs.set(10, go::errorf("a"));
+			errs.set(10, go::errorf("b"));
+			expect(errs.count() == 1_ul);
+			expect(errs.get(10).message() == "b");
+
+			errs.set(10, go::error());
+			expect(errs.any() == false);
+			expect(errs.is_error(10) == false);
+		};
+
+		should("resize drops removed rows") = [] {
+			go::error_column errs(100);
+			errs.set(10, go::errorf("a"));
+			errs.set(90, go::errorf("b"));
+
+			errs.resize(50);
+			expect(errs.count() == 1_ul);
+			expect(errs.first_error(11) == go::error_column::npos);
+
+			errs.resize(200);
+			expect(errs.is_error(90) == false);
+			expect(errs.count(0, 200) == 1_ul);
+
+			errs.clear();
+			expect(errs.size() == 200_ul);
+			expect(errs.any(0, 200) == false);
+		};
+
+		should("multi errors carry row numbers") = [] {
+			auto errInvalid = go::errorf("invalid");
+			go::error_column errs(10);
+			errs.set(2, errInvalid);
+			errs.set(7, go::errorf("too long"));
+
+			auto err = errs.to_multi_error();
+			expect(err.unwrap_multiple().size() == 2_ul);
+			expect(err.message() == "2 errors occurred:\n\t* row 2: invalid\n\t* row 7: too long\n\n") << err.message();
+			expect(go::is_error(err, errInvalid));
+
+			go::error_row row;
+			expect(go::as_error(err, row));
+			expect(row->row() == 2_ul);
+		};
+	};
+
+	return 0;
+}
@@ -0,0 +1,419 @@
+#pragma once
+
+#include <go/error.hpp>
+#include <go/hash.hpp>
+#include <go/memoize.hpp>
+#include <go/render.hpp>
+#include <go/wrap.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace go
+{
+    /// \cond TEMPLATE_DETAILS
+    namespace detail
+    {
+        template <class T>
+        struct is_duration : std::false_type {};
+
+        template <class Rep, class Period>
+        struct is_duration<std::chrono::duration<Rep, Period>> : std::true_type {};
+    }
+    /// \endcond
+
+    /*! \addtogroup fields
+     * @{
+     */
+
+    /// Value of a `go::field`.
+    using field_value = std::variant<
+        std::int64_t,
+        std::uint64_t,
+        double,
+        bool,
+        std::string_view,
+        std::chrono::nanoseconds
+    >;
+
+    /// A single typed key/value pair attached to an error.
+    /*!
+     * Integers, floating point numbers, booleans, strings and `std::chrono` durations
+     * are supported. Strings are viewed, not copied by the field itself: errors created
+     * by `go::with_fields` copy keys and string values into their own storage.
+     */
+    struct field
+    {
+        /// Name of the field.
+        std::string_view key;
+
+        /// Value of the field.
+        field_value value;
+
+        /// Creates a field from any supported value type.
+        template <class T>
+        field(std::string_view key, T const& v) :
+            key(key), value(to_value(v))
+        {}
+
+    private:
+        template <class T>
+        static auto to_value(T const& v) -> field_value
+        {
+            if constexpr (std::is_same_v<T, bool>)
+                return v;
+            else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+                return static_cast<std::int64_t>(v);
+            else if constexpr (std::is_integral_v<T>)
+                return static_cast<std::uint64_t>(v);
+            else if constexpr (std::is_floating_point_v<T>)
+                return static_cast<double>(v);
+            else if constexpr (std::is_convertible_v<T const&, std::string_view>)
+                return std::string_view(v);
+            else
+            {
+                static_assert(detail::is_duration<T>::value,
+                    "go::field expects an integer, floating point, boolean, string or std::chrono::duration value");
+
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(v);
+            }
+        }
+    };
+
+    /// A contiguous range of fields.
+    struct field_range
+    {
+        /// Pointer to the first field.
+        field const* first = nullptr;
+
+        /// Pointer past the last field.
+        field const* last = nullptr;
+
+        /// Begin iterator.
+        auto begin() const -> field const* { return first; }
+
+        /// End iterator.
+        auto end() const -> field const* { return last; }
+
+        /// Number of fields in the range.
+        auto size() const -> std::size_t { return static_cast<std::size_t>(last - first); }
+    };
+
+    /// Implemented by error data that carries structured fields.
+    struct fields_interface
+    {
+        /// Returns fields attached to this particular error, not including wrapped errors.
+        virtual auto fields() const -> field_range = 0;
+
+        virtual ~fields_interface() noexcept = default;
+    };
+
+    /*! @} */
+
+    /*! \addtogroup predefined Predefined errors
+     * @{
+     */
+
+    /// Error data for errors created by `go::with_fields`.
+    /*!
+     * Wraps another error and keeps N fields in an inline array. Keys and string
+     * values are copied into a single buffer owned by the error. The message is
+     * the wrapped error's message as-is, memoized after the first call.
+     */
+    template <std::size_t N>
+    struct error_fields_data : public error_interface, public fields_interface, public hashable_interface,
+        public memoized_message, public composite_message_interface
+    {
+        /// Wraps err with the given fields.
+        error_fields_data(error err, std::array<field, N> fields) :
+            err_(std::move(err)), fields_(std::move(fields))
+        {
+            std::size_t total = 0;
+            for (auto& f : fields_)
+            {
+                total += f.key.size();
+                if (auto str = std::get_if<std::string_view>(&f.value))
+                    total += str->size();
+            }
+
+            // Views are repointed right away, so the buffer must never reallocate
+            strings_.reserve(total);
+            for (auto& f : fields_)
+            {
+                f.key = store(f.key);
+                if (auto str = std::get_if<std::string_view>(&f.value))
+                    *str = store(*str);
+            }
+        }
+
+        error_fields_data(error_fields_data const&) = delete;
+        error_fields_data& operator=(error_fields_data const&) = delete;
+
+        /// Returns the wrapped error's message.
+        auto message() const -> std::string override
+        {
+            return std::string(message_view());
+        }
+
+        /// Returns the wrapped error.
+        auto unwrap() const -> error override
+        {
+            return err_;
+        }
+
+        /// Nothing around the wrapped error's message.
+        auto message_layout() const -> go::message_layout override
+        {
+            return {};
+        }
+
+        /// Returns the fields this error was created with.
+        auto fields() const -> field_range override
+        {
+            return {fields_.data(), fields_.data() + N};
+        }
+
+        /// Hashes the keys and values of the fields.
+        auto hash() const noexcept -> std::size_t override
+        {
+            std::size_t h = N;
+            for (auto& f : fields_)
+            {
+                h = detail::hash_combine(h, std::hash<std::string_view>()(f.key));
+                h = detail::hash_combine(h, f.value.index());
+                h = detail::hash_combine(h, std::visit([](auto const& v) -> std::size_t
+                {
+                    using T = std::decay_t<decltype(v)>;
+                    if constexpr (std::is_same_v<T, std::chrono::nanoseconds>)
+                        return std::hash<std::chrono::nanoseconds::rep>()(v.count());
+                    else
+                        return std::hash<T>()(v);
+                }, f.value));
+            }
+
+            return h;
+        }
+
+        /// Compares the keys and values of the fields in order.
+        auto equals(error_interface const& other) const noexcept -> bool override
+        {
+            auto& rhs = static_cast<error_fields_data const&>(other).fields_;
+            for (std::size_t i = 0; i < N; i++)
+            {
+                if (fields_[i].key != rhs[i].key || fields_[i].value != rhs[i].value)
+                    return false;
+            }
+
+            return true;
+        }
+
+    protected:
+        auto tree_hash_cacheable() const noexcept -> bool override
+        {
+            return true;
+        }
+
+        auto render_message() const -> std::string override
+        {
+            std::string msg;
+            append_message(msg, err_);
+            return msg;
+        }
+
+    private:
+        auto store(std::string_view str) -> std::string_view
+        {
+            auto offset = strings_.size();
+            strings_.append(str);
+            return std::string_view(strings_.data() + offset, str.size());
+        }
+
+        error err_;
+        std::array<field, N> fields_;
+        std::string strings_;
+    };
+
+    /// Error type created by `go::with_fields`.
+    template <std::size_t N>
+    using error_fields = error_of<error_fields_data<N>>;
+
+    /*! @} */
+
+    /*! \addtogroup fields
+     * @{
+     */
+
+    /// Wraps err with structured fields. Wrapping an empty error returns an empty error.
+    template <class... Fields>
+    auto with_fields(error err, Fields&&... fields) -> error
+    {
+        static_assert((std::is_convertible_v<Fields, field> && ...), "with_fields expects go::field arguments");
+
+        if (!err)
+            return {};
+
+        return make_error<error_fields<sizeof...(Fields)>>(
+            std::move(err),
+            std::array<field, sizeof...(Fields)>{field(std::forward<Fields>(fields))...});
+    }
+
+    /// Calls f for every field in err's tree, in the order `go::is_error` visits errors.
+    /*!
+     * Fields of outer errors come before fields of the errors they wrap. No messages are
+     * rendered. The fields are only valid as long as err is alive.
+     */
+    template <class F>
+    auto for_each_field(error const& err, F&& f) -> void
+    {
+        detail::wrapping_impl::walk(err, traversal_options{}, [&](error const& node)
+        {
+            if (auto withFields = dynamic_cast<fields_interface const*>(node.data().get()))
+            {
+                for (auto& fld : withFields->fields())
+                    f(fld);
+            }
+
+            return false;
+        });
+    }
+
+    /// Returns all fields in err's tree. Refer to `go::for_each_field`.
+    inline auto fields(error const& err) -> std::vector<field>
+    {
+        std::vector<field> result;
+        for_each_field(err, [&](field const& f) { result.push_back(f); });
+        return result;
+    }
+
+    /// Writes a key or string value in its logfmt representation.
+    /*!
+     * Strings are quoted when they are empty or contain spaces, `=`, quotes,
+     * backslashes or control characters. Inside quotes, quotes and backslashes are
+     * escaped with a backslash, `\n`, `\r` and `\t` are written as such and other
+     * control characters as `\u00XX`.
+     */
+    inline auto write_logfmt_string(std::ostream& os, std::string_view str) -> void
+    {
+        auto needsEscape = [](char c)
+        {
+            auto u = static_cast<unsigned char>(c);
+            return c == '"' || c == '\\' || u < 0x20 || u == 0x7F;
+        };
+
+        bool quote = str.empty();
+        for (char c : str)
+            quote = quote || c == ' ' || c == '=' || needsEscape(c);
+
+        if (!quote)
+        {
+            os << str;
+            return;
+        }
+
+        os << '"';
+        for (char c : str)
+        {
+            if (!needsEscape(c))
+            {
+                os << c;
+                continue;
+            }
+
+            switch (c)
+            {
+            case '"': os << "\\\""; break;
+            case '\\': os << "\\\\"; break;
+            case '\n': os << "\\n"; break;
+            case '\r': os << "\\r"; break;
+            case '\t': os << "\\t"; break;
+            default:
+            {
+                constexpr char digits[] = "0123456789abcdef";
+                auto u = static_cast<unsigned char>(c);
+                os << "\\u00" << digits[u >> 4] << digits[u & 0xF];
+            }
+            }
+        }
+        os << '"';
+    }
+
+    /// Writes a field value in its logfmt representation.
+    /*!
+     * Durations are written in nanoseconds with an `ns` suffix. Strings are written
+     * with `go::write_logfmt_string`.
+     */
+    inline auto write_logfmt_value(std::ostream& os, field_value const& value) -> void
+    {
+        std::visit([&](auto const& v)
+        {
+            using T = std::decay_t<decltype(v)>;
+
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                os << (v ? "true" : "false");
+            }
+            else if constexpr (std::is_same_v<T, std::string_view>)
+            {
+                write_logfmt_string(os, v);
+            }
+            else if constexpr (std::is_same_v<T, std::chrono::nanoseconds>)
+            {
+                os << v.count() << "ns";
+            }
+            else
+            {
+                os << v;
+            }
+        }, value);
+    }
+
+    /// Sink that emits errors as logfmt records, one line per error.
+    /*!
+     * A record consists of the error message under the `msg` key followed by all
+     * fields of the error's tree. Keys are quoted and escaped like string values
+     * if they need to be:
+     *
+     * ```
+     * msg="loading config: no such file" path=/etc/app.conf attempt=3
+     * ```
+     */
+    class logfmt_sink
+    {
+    public:
+        /// Creates a sink writing into os. The stream must outlive the sink.
+        explicit logfmt_sink(std::ostream& os) : os_(os) {}
+
+        /// Writes a single record for err. Empty errors are not written.
+        auto write(error const& err) -> void
+        {
+            if (!err)
+                return;
+
+            os_ << "msg=";
+            write_logfmt_value(os_, std::string_view(err.message()));
+
+            for_each_field(err, [&](field const& f)
+            {
+                os_ << ' ';
+                write_logfmt_string(os_, f.key);
+                os_ << '=';
+                write_logfmt_value(os_, f.value);
+            });
+
+            os_ << '\n';
+        }
+
+    private:
+        std::ostream& os_;
+    };
+
+    /*! @} */
+}
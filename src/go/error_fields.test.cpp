@@ -0,0 +1,147 @@
+#include <go/error_fields.hpp>
+#include <go/error_chain.hpp>
+#include <go/errorf.hpp>
+
+#include <boost/ut.hpp>
+using namespace boost::ut;
+
+#include <sstream>
+#include <string>
+
+using namespace std::chrono_literals;
+
+int main()
+{
+	"with_fields"_test = [] {
+		should("fields wrap the error without changing its message") = [] {
+			auto root = go::errorf("connection refused");
+			auto err = go::with_fields(root, go::field("port", 8080));
+
+			expect(err.message() == root.message()) << "got" << err.message();
+			expect(err.unwrap() == root);
+			expect(go::is_error(err, root));
+		};
+
+		should("wrapping an empty error returns an empty error") = [] {
+			auto err = go::with_fields(go::error(), go::field("port", 8080));
+
+			expect(err == false);
+		};
+
+		should("values keep their types") = [] {
+			std::string host = "db-1";
+			unsigned retries = 3u;
+
+			auto err = go::with_fields(go::errorf("x"),
+				go::field("attempt", -2),
+				go::field("retries", retries),
+				go::field("ratio", 0.5),
+				go::field("fatal", true),
+				go::field("host", host),
+				go::field("elapsed", 250ms));
+
+			auto got = go::fields(err);
+			expect(got.size() == 6_ul);
+
+			expect(std::get<std::int64_t>(got[0].value) == -2);
+			expect(std::get<std::uint64_t>(got[1].value) == 3u);
+			expect(std::get<double>(got[2].value) == 0.5);
+			expect(std::get<bool>(got[3].value) == true);
+			expect(std::get<std::string_view>(got[4].value) == "db-1");
+			expect(std::get<std::chrono::nanoseconds>(got[5].value) == 250ms);
+		};
+
+		should("string keys and values are owned by the error") = [] {
+			go::error err;
+			{
+				std::string key = "temporary key that doesn't fit small buffers";
+				std::string value = "temporary value";
+				err = go::with_fields(go::errorf("x"), go::field(key, value));
+				key.assign(key.size(), '-');
+				value.assign(value.size(), '-');
+			}
+
+			auto got = go::fields(err);
+			expect(got.size() == 1_ul);
+			expect(got[0].key == "temporary key that doesn't fit small buffers");
+			expect(std::get<std::string_view>(got[0].value) == "temporary value");
+		};
+	};
+
+	"fields"_test = [] {
+		should("an error without fields has none") = [] {
+			expect(go::fields(go::errorf("x")).empty());
+			expect(go::fields(go::error()).empty());
+		};
+
+		should("fields of the whole chain are listed outer first") = [] {
+			auto err = go::with_fields(go::errorf("x"), go::field("inner", 1));
+			err = go::wrap_error(std::move(err), "context");
+			err = go::with_fields(err, go::field("outer", 2), go::field("outer2", 3));
+
+			auto got = go::fields(err);
+			expect(got.size() == 3_ul);
+			expect(got[0].key == "outer");
+			expect(got[1].key == "outer2");
+			expect(got[2].key == "inner");
+		};
+
+		should("fields_interface can be found via as_error") = [] {
+			auto err = go::wrap_error(go::with_fields(go::errorf("x"), go::field("a", 1)), "context");
+
+			go::fields_interface* withFields = nullptr;
+			expect(go::as_error(err, withFields));
+			expect(withFields->fields().size() == 1_ul);
+		};
+	};
+
+	"logfmt_sink"_test = [] {
+		should("record contains the message and all fields") = [] {
+			auto err = go::with_fields(go::errorf("no such file"),
+				go::field("path", "/etc/app.conf"),
+				go::field("user", "John Doe"),
+				go::field("timeout", 2ms),
+				go::field("ok", false));
+			err = go::wrap_error(std::move(err), "loading config");
+
+			std::stringstream ss;
+			go::logfmt_sink sink(ss);
+			sink.write(err);
+
+			auto want = std::string(R"(msg="loading config: no such file" path=/etc/app.conf user="John Doe" timeout=2000000ns ok=false)") + "\n";
+			expect(ss.str() == want) << "got" << ss.str() << "want" << want;
+		};
+
+		should("quotes inside strings are escaped") = [] {
+			std::stringstream ss;
+			go::logfmt_sink sink(ss);
+			sink.write(go::errorf("say \"hi\""));
+
+			auto want = std::string(R"(msg="say \"hi\"")") + "\n";
+			expect(ss.str() == want) << "got" << ss.str() << "want" << want;
+		};
+
+		should("keys and values are escaped") = [] {
+			auto err = go::with_fields(go::errorf("a\\b\r"),
+				go::field("my key", "C:\\temp"),
+				go::field("k=\"v\"", "tab\tbell\a"));
+
+			std::stringstream ss;
+			go::logfmt_sink sink(ss);
+			sink.write(err);
+
+			auto want = std::string(R"(msg="a\\b\r" "my key"="C:\\temp" "k=\"v\""="tab\tbell\u0007")") + "\n";
+			expect(ss.str() == want) << "got" << ss.str() << "want" << want;
+		};
+
+		should("empty errors are not written") = [] {
+			std::stringstream ss;
+			go::logfmt_sink sink(ss);
+			sink.write(go::error());
+
+			expect(ss.str().empty());
+		};
+	};
+
+	return 0;
+}
@@ -0,0 +1,360 @@
+#pragma once
+
+#include <go/error.hpp>
+#include <go/wrap.hpp>
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace go
+{
+    /*! \addtogroup core
+     * @{
+     */
+
+    /// Passed to `go::error_set::match` handlers when the set holds no error.
+    struct no_error {};
+
+    /// Error data up to this size is kept inline by `go::error_set::make`.
+    inline constexpr std::size_t error_set_inline_size = 64;
+
+    /*! @} */
+
+    /// \cond TEMPLATE_DETAILS
+    namespace detail
+    {
+        template <class T>
+        struct is_error_of : std::false_type {};
+
+        template <class Impl>
+        struct is_error_of<error_of<Impl>> : std::true_type {};
+
+        template <class T, class... Ts>
+        inline constexpr bool is_one_of = (std::is_same_v<T, Ts> || ...);
+
+        template <class... Ts>
+        struct are_unique : std::true_type {};
+
+        template <class T, class... Ts>
+        struct are_unique<T, Ts...> :
+            std::bool_constant<!is_one_of<T, Ts...> && are_unique<Ts...>::value>
+        {};
+
+        /// Error data that `go::error_set` may keep by value instead of behind a shared_ptr.
+        template <class Impl>
+        inline constexpr bool inline_error_data =
+            sizeof(Impl) <= error_set_inline_size
+            && std::is_copy_constructible_v<Impl>
+            && std::is_nothrow_move_constructible_v<Impl>;
+
+        template <class... Variants>
+        struct variant_cat;
+
+        template <class... Ts>
+        struct variant_cat<std::variant<Ts...>>
+        {
+            using type = std::variant<Ts...>;
+        };
+
+        template <class... Ts, class... Us, class... Rest>
+        struct variant_cat<std::variant<Ts...>, std::variant<Us...>, Rest...>
+        {
+            using type = typename variant_cat<std::variant<Ts..., Us...>, Rest...>::type;
+        };
+
+        template <class Error>
+        using inline_alternative = std::conditional_t<
+            inline_error_data<typename Error::impl_type>,
+            std::variant<typename Error::impl_type>,
+            std::variant<>>;
+
+        /// Holds nothing, a shared error of one of Errors, or inline data of one of them.
+        template <class... Errors>
+        using error_set_storage = typename variant_cat<
+            std::variant<std::monostate, Errors...>,
+            inline_alternative<Errors>...>::type;
+
+        template <class... Fs>
+        struct overloaded : Fs... { using Fs::operator()...; };
+
+        template <class... Fs>
+        overloaded(Fs...) -> overloaded<Fs...>;
+    } // namespace detail
+    /// \endcond
+
+    /*! \addtogroup core
+     * @{
+     */
+
+    /// A closed set of error types, for functions that can only fail in a few known ways.
+    /*!
+     * A function returning `go::error_set<go::error_code, error_parse>` tells its callers
+     * exactly which errors to expect, and callers can dispatch on them with `match`,
+     * `is` and `get_if`, which switch on a small tag without `dynamic_cast` or virtual
+     * calls. The set converts to `go::error` where the open error type is expected.
+     *
+     * ```
+     * auto parse(std::string_view text) -> go::error_set<go::error_code, error_parse>;
+     *
+     * auto result = parse(text);
+     * result.match(
+     *     [](go::no_error) { ... },
+     *     [](go::error_code_data const& code) { ... },
+     *     [](error_parse_data const& parse) { ... });
+     * ```
+     *
+     * Errors created with `make` keep their data inline, without an allocation, if it is
+     * small, copyable and nothrow movable. Such errors are values: converting them to
+     * `go::error` allocates a copy each time, so they never compare equal as sentinels
+     * do. Existing errors, sentinels included, are stored as they are and keep their
+     * identity.
+     */
+    template <class... Errors>
+    class error_set
+    {
+        static_assert(sizeof...(Errors) > 0, "error_set expects at least one error type");
+        static_assert(detail::are_unique<Errors...>::value, "error_set expects distinct error types");
+        static_assert((detail::is_error_of<Errors>::value && ...), "error_set expects go::error_of<T> types");
+
+    public:
+        /// Creates an empty set that holds no error.
+        error_set() = default;
+
+        /// Holds err, or no error if err is empty.
+        template <class Error, class = std::enable_if_t<detail::is_one_of<Error, Errors...>>>
+        error_set(Error err)
+        {
+            if (err)
+                storage_.template emplace<Error>(std::move(err));
+        }
+
+        /// Creates an error of type Error, inline if its data is small enough.
+        template <class Error, class... Args>
+        static auto make(Args&&... args) -> error_set
+        {
+            static_assert(detail::is_one_of<Error, Errors...>, "error_set::make expects one of the set's error types");
+
+            using impl = typename Error::impl_type;
+
+            error_set result;
+            if constexpr (detail::inline_error_data<impl>)
+                result.storage_.template emplace<impl>(std::forward<Args>(args)...);
+            else
+                result.storage_.template emplace<Error>(make_error<Error>(std::forward<Args>(args)...));
+
+            return result;
+        }
+
+        /// False if the set holds no error.
+        explicit operator bool() const noexcept
+        {
+            return storage_.index() != 0;
+        }
+
+        /// Returns 0 if the set holds no error, or 1 plus the position of the held
+        /// error's type in Errors.
+        auto index() const noexcept -> std::size_t
+        {
+            return std::visit([](auto const& alt) -> std::size_t { return position<std::decay_t<decltype(alt)>>(); }, storage_);
+        }
+
+        /// Returns true if the set holds an error of type Error.
+        template <class Error>
+        auto is() const noexcept -> bool
+        {
+            static_assert(detail::is_one_of<Error, Errors...>, "error_set::is expects one of the set's error types");
+
+            if constexpr (detail::inline_error_data<typename Error::impl_type>)
+            {
+                if (std::holds_alternative<typename Error::impl_type>(storage_))
+                    return true;
+            }
+
+            return std::holds_alternative<Error>(storage_);
+        }
+
+        /// Returns the data of the held error if it has type Error, or null.
+        template <class Error>
+        auto get_if() const noexcept -> typename Error::impl_type const*
+        {
+            static_assert(detail::is_one_of<Error, Errors...>, "error_set::get_if expects one of the set's error types");
+
+            using impl = typename Error::impl_type;
+            if constexpr (detail::inline_error_data<impl>)
+            {
+                if (auto data = std::get_if<impl>(&storage_))
+                    return data;
+            }
+
+            auto err = std::get_if<Error>(&storage_);
+            return err ? err->operator->() : nullptr;
+        }
+
+        /// Sets target to the held error if it has type Error. Inline errors are copied
+        /// into a new allocation, `get_if` gives access to them without one.
+        template <class Error>
+        auto as(Error& target) const -> bool
+        {
+            static_assert(detail::is_one_of<Error, Errors...>, "error_set::as expects one of the set's error types");
+
+            using impl = typename Error::impl_type;
+            if constexpr (detail::inline_error_data<impl>)
+            {
+                if (auto data = std::get_if<impl>(&storage_))
+                {
+                    target = make_error<Error>(*data);
+                    return true;
+                }
+            }
+
+            if (auto err = std::get_if<Error>(&storage_))
+            {
+                target = *err;
+                return true;
+            }
+
+            return false;
+        }
+
+        /// Calls the overload of fs that accepts the held error's data, or `go::no_error`
+        /// if the set is empty, and returns its result.
+        /*!
+         * The overloads must cover `go::no_error` and the data types of all Errors, and
+         * return the same type.
+         */
+        template <class... Fs>
+        auto match(Fs&&... fs) const -> decltype(auto)
+        {
+            auto handler = detail::overloaded{std::forward<Fs>(fs)...};
+            return std::visit([&](auto const& alt) -> decltype(auto)
+            {
+                using alt_type = std::decay_t<decltype(alt)>;
+                if constexpr (std::is_same_v<alt_type, std::monostate>)
+                    return handler(no_error{});
+                else if constexpr (detail::is_error_of<alt_type>::value)
+                    return handler(static_cast<typename alt_type::impl_type const&>(*alt.operator->()));
+                else
+                    return handler(alt);
+            }, storage_);
+        }
+
+        /// Returns the held error's message, or "<nil>" if the set is empty.
+        auto message() const -> std::string
+        {
+            return std::visit([](auto const& alt) -> std::string
+            {
+                using alt_type = std::decay_t<decltype(alt)>;
+                if constexpr (std::is_same_v<alt_type, std::monostate>)
+                    return "<nil>";
+                else if constexpr (detail::is_error_of<alt_type>::value)
+                    return alt.message();
+                else
+                    return alt.alt_type::message();
+            }, storage_);
+        }
+
+        /// Converts to the open error type. Inline errors are copied into a new allocation.
+        operator error() const&
+        {
+            return std::visit([](auto const& alt) -> error
+            {
+                using alt_type = std::decay_t<decltype(alt)>;
+                if constexpr (std::is_same_v<alt_type, std::monostate>)
+                    return {};
+                else if constexpr (detail::is_error_of<alt_type>::value)
+                    return alt;
+                else
+                    return make_error<error_of<alt_type>>(alt);
+            }, storage_);
+        }
+
+        /// Converts to the open error type. Inline errors are moved into a new allocation.
+        operator error() &&
+        {
+            return std::visit([](auto&& alt) -> error
+            {
+                using alt_type = std::decay_t<decltype(alt)>;
+                if constexpr (std::is_same_v<alt_type, std::monostate>)
+                    return {};
+                else if constexpr (detail::is_error_of<alt_type>::value)
+                    return std::move(alt);
+                else
+                    return make_error<error_of<alt_type>>(std::move(alt));
+            }, std::move(storage_));
+        }
+
+        template <class... Es, class Against>
+        friend auto is_error(error_set<Es...> const& set, error_of<Against> const& target) -> bool;
+
+    private:
+        template <class Alt>
+        static constexpr auto position() -> std::size_t
+        {
+            constexpr bool matches[] = {
+                (std::is_same_v<Alt, Errors> || std::is_same_v<Alt, typename Errors::impl_type>)...
+            };
+
+            for (std::size_t i = 0; i < sizeof...(Errors); i++)
+            {
+                if (matches[i])
+                    return i + 1;
+            }
+
+            return 0;
+        }
+
+        detail::error_set_storage<Errors...> storage_;
+    };
+
+    /// `go::is_error` on the held error.
+    /*!
+     * Inline errors are values, so they never match target by identity. They still
+     * match through `go::is_interface`, and the errors they wrap are checked with
+     * `go::is_error`. Their type is known statically, so no `dynamic_cast` is needed
+     * to find out whether they implement `go::is_interface`.
+     */
+    template <class... Errors, class Against>
+    auto is_error(error_set<Errors...> const& set, error_of<Against> const& target) -> bool
+    {
+        if (!set || !target)
+            return !set && !target;
+
+        return std::visit([&](auto const& alt) -> bool
+        {
+            using alt_type = std::decay_t<decltype(alt)>;
+            if constexpr (std::is_same_v<alt_type, std::monostate>)
+            {
+                return false;
+            }
+            else if constexpr (detail::is_error_of<alt_type>::value)
+            {
+                return go::is_error(alt, target);
+            }
+            else
+            {
+                using interface = is_interface<error_of<Against>>;
+                if constexpr (std::is_base_of_v<interface, alt_type>)
+                {
+                    if (static_cast<interface const&>(alt).is(target))
+                        return true;
+                }
+
+                if (auto inner = alt.alt_type::unwrap())
+                    return go::is_error(inner, target);
+
+                for (auto& child : alt.alt_type::unwrap_span())
+                {
+                    if (go::is_error(child, target))
+                        return true;
+                }
+
+                return false;
+            }
+        }, set.storage_);
+    }
+
+    /*! @} */
+}
@@ -0,0 +1,171 @@
+#include <go/error_set.hpp>
+#include <go/error_code.hpp>
+#include <go/error_string.hpp>
+#include <go/errorf.hpp>
+
+#include <boost/ut.hpp>
+using namespace boost::ut;
+
+#include <array>
+#include <cstdlib>
+#include <new>
+
+static std::size_t allocationCount = 0;
+
+void* operator new(std::size_t size)
+{
+	allocationCount++;
+
+	if (auto ptr = std::malloc(size ? size : 1))
+		return ptr;
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+struct error_parse_data : public go::error_interface
+{
+	int line;
+
+	explicit error_parse_data(int line) : line(line) {}
+
+	std::string message() const override { return "parse error at line " + std::to_string(line); }
+};
+
+using error_parse = go::error_of<error_parse_data>;
+
+// Too large to be kept inline
+struct error_dump_data : public go::error_interface
+{
+	std::array<char, 256> dump{};
+
+	std::string message() const override { return "dump"; }
+};
+
+using error_dump = go::error_of<error_dump_data>;
+
+auto errNotFound = go::make_error<go::error_string>("not found");
+
+struct error_missing_data : public go::error_interface, public go::is_interface<go::error_string>
+{
+	std::string message() const override { return "missing"; }
+
+	bool is(go::error_string const& target) const override { return target == errNotFound; }
+};
+
+using error_missing = go::error_of<error_missing_data>;
+
+using parse_result = go::error_set<go::error_code, go::error_string, error_parse, error_dump, error_missing>;
+
+auto describe(parse_result const& result) -> std::string
+{
+	return result.match(
+		[](go::no_error) { return std::string("ok"); },
+		[](go::error_code_data const& code) { return "code " + std::to_string(code.value()); },
+		[](go::error_string_data const& str) { return "string " + str.message(); },
+		[](error_parse_data const& parse) { return "line " + std::to_string(parse.line); },
+		[](error_dump_data const&) { return std::string("dump"); },
+		[](error_missing_data const&) { return std::string("missing"); });
+}
+
+int main()
+{
+	"error_set"_test = [] {
+		should("empty sets hold no error") = [] {
+			parse_result result;
+
+			expect(static_cast<bool>(result) == false);
+			expect(result.index() == 0_ul);
+			expect(result.message() == "<nil>");
+			expect(describe(result) == "ok");
+			expect(static_cast<go::error>(result) == false);
+
+			expect(static_cast<bool>(parse_result(go::error_code())) == false);
+		};
+
+		should("small errors are made inline") = [] {
+			auto result = parse_result::make<error_parse>(12);
+
+			expect(result.index() == 3_ul);
+			expect(result.is<error_parse>());
+			expect(result.is<go::error_code>() == false);
+			expect(result.get_if<error_parse>()->line == 12_i);
+			expect(result.get_if<go::error_code>() == nullptr);
+			expect(result.message() == "parse error at line 12");
+			expect(describe(result) == "line 12");
+
+			error_parse err;
+			expect(result.as(err));
+			expect(err->line == 12_i);
+
+			go::error open = result;
+			expect(open.message() == "parse error at line 12");
+			expect(go::error_cast<error_parse_data*>(open)->line == 12_i);
+		};
+
+		should("large errors and existing errors are shared") = [] {
+			auto dump = parse_result::make<error_dump>();
+			expect(dump.is<error_dump>());
+			expect(describe(dump) == "dump");
+
+			error_dump first, second;
+			expect(dump.as(first));
+			expect(dump.as(second));
+			expect(first == second);
+
+			parse_result sentinel = errNotFound;
+			expect(sentinel.index() == 2_ul);
+			expect(describe(sentinel) == "string not found");
+			expect(static_cast<go::error>(sentinel) == errNotFound);
+		};
+
+		should("is_error checks identity and is_interface") = [] {
+			parse_result sentinel = errNotFound;
+			expect(go::is_error(sentinel, errNotFound));
+			expect(go::is_error(sentinel, go::make_error<go::error_string>("not found")) == false);
+
+			auto missing = parse_result::make<error_missing>();
+			expect(go::is_error(missing, errNotFound));
+
+			auto code = parse_result::make<go::error_code>(std::make_error_code(std::errc::timed_out));
+			expect(go::is_error(code, errNotFound) == false);
+			expect(code.get_if<go::error_code>()->code() == std::errc::timed_out);
+
+			expect(go::is_error(parse_result(), go::error()));
+			expect(go::is_error(parse_result(), errNotFound) == false);
+		};
+
+		should("inline errors match without allocating") = [] {
+			auto missing = parse_result::make<error_missing>();
+			auto code = parse_result::make<go::error_code>(std::make_error_code(std::errc::timed_out));
+
+			auto before = allocationCount;
+			auto missingMatches = go::is_error(missing, errNotFound);
+			auto codeMatches = go::is_error(code, errNotFound);
+			auto allocations = allocationCount - before;
+
+			expect(missingMatches);
+			expect(codeMatches == false);
+			expect(allocations == 0_ul) << "got" << allocations << "allocations, want none";
+		};
+
+		should("moved sets convert without copying shared errors") = [] {
+			auto err = go::errorf("boom");
+			parse_result result = go::error_string(go::error_cast<go::error_string>(err));
+
+			go::error open = std::move(result);
+			expect(open == err);
+		};
+	};
+
+	return 0;
+}
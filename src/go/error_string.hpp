@@ -4,11 +4,21 @@
 
 namespace go
 {
+    /// \cond TEMPLATE_DETAILS
+    namespace detail
+    {
+        struct hash_impl;
+    }
+    /// \endcond
+
     /*! \addtogroup predefined Predefined errors
      * @{
      */
 
     /// Error data for `go::error_string`.
+    /*!
+     * `go::error_hash` and `go::error_value_equal` compare it by its message.
+     */
     struct error_string_data : public error_interface
     {
         /// Initialize with a predefined message.
@@ -21,6 +31,8 @@ namespace go
 
     private:
         std::string msg;
+
+        friend struct detail::hash_impl;
     };
 
     /// Simple error type that encapsulates a single predefined string.
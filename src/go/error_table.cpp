@@ -0,0 +1,235 @@
+#include <go/error_table.hpp>
+#include <go/errorf.hpp>
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+namespace go
+{
+    namespace
+    {
+        constexpr std::uint32_t index_mask = (std::uint32_t(1) << error_table::index_bits) - 1;
+        constexpr std::uint32_t generation_mask = (std::uint32_t(1) << error_table::generation_bits) - 1;
+
+        // Slots are grouped into pages that never move, so that growing a shard
+        // doesn't copy the errors it already holds
+        constexpr std::size_t page_bits = 12;
+        constexpr std::size_t page_size = std::size_t(1) << page_bits;
+
+        // Released slots are reused oldest first, and only once this many are free,
+        // so a slot's generation wraps around only after the shard releases errors
+        // this many times over
+        constexpr std::size_t min_free_slots = 1024;
+
+        struct slot
+        {
+            error err;
+
+            // Never zero, so that no handle packs to zero
+            std::uint8_t generation = 1;
+        };
+
+        auto pack(std::size_t shard, std::uint32_t index, std::uint8_t generation) -> std::uint32_t
+        {
+            return (static_cast<std::uint32_t>(shard) << (error_table::index_bits + error_table::generation_bits))
+                | (index << error_table::generation_bits)
+                | generation;
+        }
+
+        auto next_generation(std::uint8_t generation) -> std::uint8_t
+        {
+            return generation == generation_mask ? 1 : static_cast<std::uint8_t>(generation + 1);
+        }
+
+        // Spreads inserting threads over the shards
+        auto home_shard() -> std::size_t
+        {
+            static std::atomic<std::size_t> nextThread{0};
+            thread_local std::size_t home = nextThread.fetch_add(1, std::memory_order_relaxed);
+            return home;
+        }
+    }
+
+    struct error_table::shard
+    {
+        mutable std::shared_mutex mutex;
+        std::vector<std::unique_ptr<slot[]>> pages;
+        std::uint32_t used = 0;
+        std::deque<std::uint32_t> freeSlots;
+        std::size_t size = 0;
+
+        auto at(std::uint32_t index) const -> slot&
+        {
+            return pages[index >> page_bits][index & (page_size - 1)];
+        }
+
+        // Returns the slot matching handle, with the lock held by the caller
+        auto lookup(std::uint32_t raw) const -> slot*
+        {
+            auto index = (raw >> generation_bits) & index_mask;
+            if (index >= used)
+                return nullptr;
+
+            auto& s = at(index);
+            if (s.generation != (raw & generation_mask) || !s.err)
+                return nullptr;
+
+            return &s;
+        }
+    };
+
+    error_table::error_table() :
+        shards_(new shard[shard_count])
+    {}
+
+    error_table::~error_table() = default;
+
+    auto error_table::global() -> error_table&
+    {
+        // Leaked, so that handles stay valid in destructors of other statics
+        static auto table = new error_table();
+        return *table;
+    }
+
+    auto error_table::insert(error err) -> std::pair<error_handle, error>
+    {
+        if (!err)
+            return {};
+
+        auto home = home_shard();
+        for (std::size_t attempt = 0; attempt < shard_count; attempt++)
+        {
+            auto shardIndex = (home + attempt) % shard_count;
+            auto& s = shards_[shardIndex];
+            std::unique_lock<std::shared_mutex> lock(s.mutex);
+
+            std::uint32_t index;
+            if (s.freeSlots.size() > min_free_slots || (s.used == shard_capacity && !s.freeSlots.empty()))
+            {
+                index = s.freeSlots.front();
+                s.freeSlots.pop_front();
+            }
+            else if (s.used < shard_capacity)
+            {
+                index = s.used;
+                if ((index & (page_size - 1)) == 0)
+                    s.pages.emplace_back(new slot[page_size]);
+
+                s.used++;
+            }
+            else
+            {
+                continue;
+            }
+
+            auto& target = s.at(index);
+            target.err = std::move(err);
+            s.size++;
+
+            return {error_handle(pack(shardIndex, index, target.generation)), {}};
+        }
+
+        return {{}, errorf("go::error_table::insert: all ", shard_count, " shards hold ", shard_capacity, " errors")};
+    }
+
+    auto error_table::find(error_handle handle) const -> shard*
+    {
+        if (!handle)
+            return nullptr;
+
+        return &shards_[handle.raw_ >> (index_bits + generation_bits)];
+    }
+
+    auto error_table::get(error_handle handle) const -> error
+    {
+        auto s = find(handle);
+        if (!s)
+            return {};
+
+        std::shared_lock<std::shared_mutex> lock(s->mutex);
+        auto found = s->lookup(handle.raw_);
+        return found ? found->err : error();
+    }
+
+    auto error_table::contains(error_handle handle) const -> bool
+    {
+        auto s = find(handle);
+        if (!s)
+            return false;
+
+        std::shared_lock<std::shared_mutex> lock(s->mutex);
+        return s->lookup(handle.raw_) != nullptr;
+    }
+
+    auto error_table::release(error_handle handle) -> bool
+    {
+        auto s = find(handle);
+        if (!s)
+            return false;
+
+        error released;
+        {
+            std::unique_lock<std::shared_mutex> lock(s->mutex);
+            auto found = s->lookup(handle.raw_);
+            if (!found)
+                return false;
+
+            released = std::move(found->err);
+            found->generation = next_generation(found->generation);
+            s->freeSlots.push_back((handle.raw_ >> generation_bits) & index_mask);
+            s->size--;
+        }
+
+        // The error is destroyed outside of the lock, as its destructor may be arbitrarily expensive
+        return true;
+    }
+
+    auto error_table::release_all() -> void
+    {
+        for (std::size_t i = 0; i < shard_count; i++)
+        {
+            auto& s = shards_[i];
+
+            std::vector<error> released;
+            {
+                std::unique_lock<std::shared_mutex> lock(s.mutex);
+                released.reserve(s.size);
+
+                s.freeSlots.clear();
+                for (std::uint32_t index = 0; index < s.used; index++)
+                {
+                    auto& target = s.at(index);
+                    if (target.err)
+                    {
+                        released.push_back(std::move(target.err));
+                        target.generation = next_generation(target.generation);
+                    }
+
+                    s.freeSlots.push_back(index);
+                }
+
+                s.size = 0;
+            }
+        }
+    }
+
+    auto error_table::size() const -> std::size_t
+    {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < shard_count; i++)
+        {
+            std::shared_lock<std::shared_mutex> lock(shards_[i].mutex);
+            total += shards_[i].size;
+        }
+
+        return total;
+    }
+
+    auto error_table::message(error_handle handle) const -> std::string
+    {
+        return get(handle).message();
+    }
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <go/error.hpp>
+#include <go/wrap.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace go
+{
+    /*! \addtogroup core
+     * @{
+     */
+
+    /// A 32-bit reference to an error stored in a `go::error_table`.
+    /*!
+     * A handle packs the table shard, the slot within the shard and the generation
+     * of the slot. Releasing the error bumps the generation, so stale handles stop
+     * resolving instead of pointing to whatever error reuses the slot. Released
+     * slots are reused oldest first and only once 1024 of them are free, so the
+     * 8-bit generation of a slot wraps around only after its shard released
+     * hundreds of thousands of errors.
+     *
+     * The default handle is empty and never refers to an error.
+     */
+    class error_handle
+    {
+    public:
+        /// Creates an empty handle.
+        constexpr error_handle() noexcept = default;
+
+        /// Recreates a handle from the value returned by `raw`.
+        static constexpr auto from_raw(std::uint32_t raw) noexcept -> error_handle
+        {
+            return error_handle(raw);
+        }
+
+        /// Returns the handle packed into 32 bits.
+        constexpr auto raw() const noexcept -> std::uint32_t
+        {
+            return raw_;
+        }
+
+        /// False for the empty handle.
+        constexpr explicit operator bool() const noexcept
+        {
+            return raw_ != 0;
+        }
+
+        /// Handles are equal if they refer to the same slot and generation.
+        friend constexpr auto operator==(error_handle lhs, error_handle rhs) noexcept -> bool
+        {
+            return lhs.raw_ == rhs.raw_;
+        }
+
+        /// Handles are equal if they refer to the same slot and generation.
+        friend constexpr auto operator!=(error_handle lhs, error_handle rhs) noexcept -> bool
+        {
+            return lhs.raw_ != rhs.raw_;
+        }
+
+    private:
+        constexpr explicit error_handle(std::uint32_t raw) noexcept : raw_(raw) {}
+
+        std::uint32_t raw_ = 0;
+
+        friend class error_table;
+    };
+
+    /// Table of errors referred to by 32-bit `go::error_handle` values.
+    /*!
+     * Structures that are kept in large numbers can store a 4 byte handle instead of
+     * a two-word `go::error`, and copying handles doesn't touch reference counts. The
+     * table owns the errors: an error stays alive until its handle is released or the
+     * whole table is cleared with `release_all`, no matter how many copies of the
+     * handle exist.
+     *
+     * ```
+     * auto [handle, err] = go::error_table::global().insert(go::errorf("timed out"));
+     * entry.status = handle;
+     * ...
+     * if (go::error_table::global().is_error(entry.status, errTimeout))
+     *     retry(entry);
+     * ```
+     *
+     * The table is split into 16 shards of up to 2^20 errors each, and threads insert
+     * into different shards, so they rarely contend. Lookups take a shared lock of
+     * a single shard. The table is thread-safe.
+     */
+    class error_table
+    {
+    public:
+        /// Number of bits of a handle that select the shard.
+        static constexpr unsigned shard_bits = 4;
+
+        /// Number of bits of a handle that select the slot within a shard.
+        static constexpr unsigned index_bits = 20;
+
+        /// Number of bits of a handle that hold the generation of the slot.
+        static constexpr unsigned generation_bits = 8;
+
+        /// Maximum number of errors a single shard holds.
+        static constexpr std::size_t shard_capacity = std::size_t(1) << index_bits;
+
+        /// Creates an empty table.
+        error_table();
+
+        /// Releases all errors.
+        ~error_table();
+
+        error_table(error_table const&) = delete;
+        error_table& operator=(error_table const&) = delete;
+
+        /// Returns the process-wide table.
+        static auto global() -> error_table&;
+
+        /// Stores err and returns its handle. Storing an empty error returns an empty handle.
+        /*!
+         * Fails only when all the shards are full.
+         */
+        auto insert(error err) -> std::pair<error_handle, error>;
+
+        /// Returns the error of handle, or an empty error for empty or stale handles.
+        auto get(error_handle handle) const -> error;
+
+        /// Returns true if handle refers to an error that wasn't released.
+        auto contains(error_handle handle) const -> bool;
+
+        /// Releases the error of handle. Returns false if the handle was empty or stale.
+        auto release(error_handle handle) -> bool;
+
+        /// Releases all errors of the table at once, making every handle stale.
+        auto release_all() -> void;
+
+        /// Returns the number of stored errors.
+        auto size() const -> std::size_t;
+
+        /// `go::is_error` on the error of handle. Stale handles hold no error.
+        /*!
+         * The error is copied out of the table first, so `go::is_interface`
+         * implementations may call into the table.
+         */
+        template <class Against>
+        auto is_error(error_handle handle, error_of<Against> const& target, traversal_options const& options = {}) const -> bool
+        {
+            return go::is_error(get(handle), target, options);
+        }
+
+        /// `go::as_error` on the error of handle. Stale handles hold no error.
+        template <class To>
+        auto as_error(error_handle handle, To& target, traversal_options const& options = {}) const -> bool
+        {
+            return go::as_error(get(handle), target, options);
+        }
+
+        /// Returns the message of the error of handle, or "<nil>" for stale handles.
+        auto message(error_handle handle) const -> std::string;
+
+    private:
+        struct shard;
+
+        static constexpr std::size_t shard_count = std::size_t(1) << shard_bits;
+
+        auto find(error_handle handle) const -> shard*;
+
+        std::unique_ptr<shard[]> shards_;
+    };
+
+    /*! @} */
+}
@@ -0,0 +1,172 @@
+#include <go/error_table.hpp>
+#include <go/error_chain.hpp>
+#include <go/errorf.hpp>
+
+#include <boost/ut.hpp>
+using namespace boost::ut;
+
+#include <thread>
+
+// Releases its own handle while is_error runs on it
+struct error_releasing_data : public go::error_interface, public go::is_interface<go::error>
+{
+	go::error_table* table = nullptr;
+	go::error_handle handle;
+
+	std::string message() const override { return "releasing"; }
+
+	bool is(go::error const&) const override
+	{
+		table->insert(go::errorf("inserted"));
+		return table->release(handle);
+	}
+};
+
+using error_releasing = go::error_of<error_releasing_data>;
+
+int main()
+{
+	"error_table"_test = [] {
+		should("handles resolve to their errors") = [] {
+			go::error_table table;
+			auto errTimeout = go::errorf("timed out");
+
+			auto [handle, err] = table.insert(go::wrap_error(errTimeout, "fetching"));
+			expect(err == false);
+			expect(static_cast<bool>(handle));
+			expect(sizeof(handle) == 4_ul);
+
+			expect(table.contains(handle));
+			expect(table.size() == 1_ul);
+			expect(table.message(handle) == "fetching: timed out");
+			expect(table.is_error(handle, errTimeout));
+
+			go::error_frame frame;
+			expect(table.as_error(handle, frame));
+			expect(frame->context() == "fetching");
+
+			auto copy = go::error_handle::from_raw(handle.raw());
+			expect(copy == handle);
+			expect(table.get(copy).message() == "fetching: timed out");
+		};
+
+		should("empty errors and handles hold nothing") = [] {
+			go::error_table table;
+
+			auto [handle, err] = table.insert(go::error());
+			expect(err == false);
+			expect(static_cast<bool>(handle) == false);
+
+			expect(table.get(go::error_handle()) == false);
+			expect(table.contains(go::error_handle()) == false);
+			expect(table.release(go::error_handle()) == false);
+			expect(table.message(go::error_handle()) == "<nil>");
+			expect(table.is_error(go::error_handle(), go::error()));
+		};
+
+		should("released handles become stale") = [] {
+			go::error_table table;
+
+			auto first = table.insert(go::errorf("first")).first;
+			expect(table.release(first));
+			expect(table.release(first) == false);
+			expect(table.get(first) == false);
+			expect(table.size() == 0_ul);
+
+			// The released slot waits in the free list instead of being reused right away
+			auto second = table.insert(go::errorf("second")).first;
+			expect(second != first);
+			expect(table.get(first) == false);
+			expect(table.message(second) == "second");
+		};
+
+		should("stale handles stay stale after many reuses") = [] {
+			go::error_table table;
+
+			auto first = table.insert(go::errorf("first")).first;
+			expect(table.release(first));
+
+			// More cycles than generations, enough to wrap a slot reused right away
+			for (int i = 0; i < 5000; i++)
+			{
+				auto handle = table.insert(go::errorf("next")).first;
+				expect(table.contains(first) == false);
+				expect(table.release(handle));
+			}
+
+			expect(table.get(first) == false);
+			expect(table.message(first) == "<nil>");
+		};
+
+		should("is_interface implementations may call into the table") = [] {
+			go::error_table table;
+			auto releasing = go::make_error<error_releasing>();
+
+			auto handle = table.insert(releasing).first;
+			releasing->table = &table;
+			releasing->handle = handle;
+
+			expect(table.is_error(handle, go::errorf("other")));
+			expect(table.contains(handle) == false);
+			expect(table.size() == 1_ul);
+		};
+
+		should("release_all releases everything at once") = [] {
+			go::error_table table;
+			auto err = go::errorf("shared");
+
+			std::vector<go::error_handle> handles;
+			for (int i = 0; i < 10000; i++)
+				handles.push_back(table.insert(err).first);
+
+			expect(table.size() == 10000_ul);
+			expect(err.data().use_count() == 10002_l);
+
+			table.release_all();
+			expect(table.size() == 0_ul);
+			expect(err.data().use_count() == 2_l);
+
+			for (auto handle : handles)
+				expect(table.contains(handle) == false);
+
+			expect(table.insert(err).first.raw() != 0_u);
+		};
+
+		should("threads insert and look up concurrently") = [] {
+			go::error_table table;
+
+			std::vector<std::thread> threads;
+			std::atomic<int> resolved{0};
+			for (int t = 0; t < 4; t++)
+			{
+				threads.emplace_back([&table, &resolved, t] {
+					std::vector<go::error_handle> handles;
+					for (int i = 0; i < 1000; i++)
+						handles.push_back(table.insert(go::errorf("thread ", t, " error ", i)).first);
+
+					for (int i = 0; i < 1000; i++)
+					{
+						if (table.message(handles[i]) == "thread " + std::to_string(t) + " error " + std::to_string(i))
+							resolved++;
+
+						table.release(handles[i]);
+					}
+				});
+			}
+
+			for (auto& thread : threads)
+				thread.join();
+
+			expect(resolved.load() == 4000_i);
+			expect(table.size() == 0_ul);
+		};
+
+		should("the global table is shared") = [] {
+			auto handle = go::error_table::global().insert(go::errorf("global")).first;
+			expect(go::error_table::global().message(handle) == "global");
+			expect(go::error_table::global().release(handle));
+		};
+	};
+
+	return 0;
+}
@@ -3,7 +3,14 @@
 #include <go/error.hpp>
 #include <go/error_string.hpp>
 
+#include <array>
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
 #include <sstream>
+#include <streambuf>
+#include <string>
+#include <string_view>
 
 namespace go
 {
@@ -29,4 +36,162 @@ namespace go
 	}
 
     /*! @} */
+
+    /// \cond TEMPLATE_DETAILS
+    namespace detail
+    {
+        /// Stream buffer that appends into a string, so that the formatted
+        /// text doesn't have to be copied out of the stream.
+        class string_append_buf : public std::streambuf
+        {
+        public:
+            std::string text;
+
+        protected:
+            auto overflow(int_type c) -> int_type override
+            {
+                if (!traits_type::eq_int_type(c, traits_type::eof()))
+                    text.push_back(traits_type::to_char_type(c));
+
+                return traits_type::not_eof(c);
+            }
+
+            auto xsputn(const char* s, std::streamsize n) -> std::streamsize override
+            {
+                text.append(s, static_cast<std::size_t>(n));
+                return n;
+            }
+        };
+
+        /// A stream reused by `go::interned_errorf` calls of a thread.
+        struct local_format_stream
+        {
+            string_append_buf buf;
+            std::ostream os{&buf};
+            bool busy = false;
+
+            static auto get() -> local_format_stream&
+            {
+                thread_local local_format_stream stream;
+                return stream;
+            }
+        };
+    } // namespace detail
+    /// \endcond
+
+    /*! \addtogroup core
+     * @{
+     */
+
+    /// A small cache of errors created by a single `go::interned_errorf` call site.
+    /*!
+     * Intended to be declared as a static variable next to the call, so that
+     * every call site has its own cache. Lookups take a shared lock, so concurrent
+     * calls that hit the cache don't block each other.
+     */
+    class errorf_site
+    {
+    public:
+        /// Number of distinct messages remembered. Older messages are replaced first.
+        static constexpr std::size_t capacity = 4;
+
+        /// Returns the cached error with message, or caches a new `go::error_string` with it.
+        auto get(std::string_view message) -> error
+        {
+            {
+                std::shared_lock<std::shared_mutex> lock(mutex_);
+                if (auto found = find(message))
+                    return found;
+            }
+
+            // Allocated outside of the lock, at the risk of losing a race to another thread
+            error created = make_error<error_string>(std::string(message));
+
+            std::unique_lock<std::shared_mutex> lock(mutex_);
+            if (auto found = find(message))
+                return found;
+
+            auto& slot = entries_[next_];
+            next_ = (next_ + 1) % capacity;
+
+            slot.message.assign(message);
+            slot.err = created;
+            return created;
+        }
+
+    private:
+        struct entry
+        {
+            std::string message;
+            error err;
+        };
+
+        auto find(std::string_view message) const -> error
+        {
+            for (auto& e : entries_)
+            {
+                if (e.err && e.message == message)
+                    return e.err;
+            }
+
+            return {};
+        }
+
+        std::shared_mutex mutex_;
+        std::array<entry, capacity> entries_;
+        std::size_t next_ = 0;
+    };
+
+    /// Like `go::errorf`, but returns a shared error when the call site recently
+    /// produced the same message.
+    /*!
+     * Meant for hot failure paths that produce the same message over and over,
+     * where each `go::errorf` call would allocate a fresh error:
+     *
+     * ```
+     * static go::errorf_site site;
+     * return go::interned_errorf(site, "upstream unavailable: ", host);
+     * ```
+     *
+     * The arguments are still formatted on every call, but into a per-thread buffer,
+     * and an error is only allocated when the message isn't in the site's cache.
+     *
+     * Errors are compared by identity, so unlike with `go::errorf`, two calls with
+     * the same message usually return errors that compare equal with `operator==`
+     * and `go::is_error`. Don't use interned errors where callers tell individual
+     * failures apart by identity, and don't use them as sentinels either, since
+     * a message may be evicted from the cache and allocated again.
+     */
+    template <class... Ts>
+    auto interned_errorf(errorf_site& site, Ts&&... args) -> error
+    {
+        auto& stream = detail::local_format_stream::get();
+
+        // Formatting an argument may itself format an interned error
+        if (stream.busy)
+            return site.get(errorf(std::forward<Ts>(args)...).message());
+
+        struct release_stream
+        {
+            bool& busy;
+            ~release_stream() { busy = false; }
+        };
+
+        stream.busy = true;
+        release_stream guard{stream.busy};
+
+        stream.buf.text.clear();
+        (stream.os << ... << std::forward<Ts>(args));
+
+        // Manipulators passed as arguments must not leak into the next call
+        stream.os.clear();
+        stream.os.flags(std::ios_base::dec | std::ios_base::skipws);
+        stream.os.precision(6);
+        stream.os.width(0);
+        stream.os.fill(' ');
+
+        return site.get(stream.buf.text);
+    }
+
+    /*! @} */
 }
@@ -13,6 +13,16 @@ std::ostream& operator<<(std::ostream& os, const os_obj& obj)
 	return os << os_obj::msg;
 }
 
+// Formats an interned error of its own while being formatted
+struct nested_obj {
+	go::errorf_site* site;
+};
+
+std::ostream& operator<<(std::ostream& os, const nested_obj& obj)
+{
+	return os << go::interned_errorf(*obj.site, "inner").message();
+}
+
 int main()
 {
 	"errorf"_test = [] {
@@ -57,5 +67,59 @@ int main()
 			expect(err == err);
 		};
 	};
+
+	"interned_errorf"_test = [] {
+		should("same message returns the same error") = [] {
+			go::errorf_site site;
+
+			auto err1 = go::interned_errorf(site, "upstream unavailable: ", "db1");
+			auto err2 = go::interned_errorf(site, "upstream unavailable: ", std::string("db1"));
+
+			expect(err1 == err2);
+			expect(err1.message() == "upstream unavailable: db1") << "got" << err1.message();
+		};
+
+		should("different messages return different errors") = [] {
+			go::errorf_site site;
+
+			auto err1 = go::interned_errorf(site, "code ", 1);
+			auto err2 = go::interned_errorf(site, "code ", 2);
+
+			expect(err1 != err2);
+			expect(err2.message() == "code 2");
+			expect(go::interned_errorf(site, "code ", 1) == err1);
+		};
+
+		should("oldest messages are evicted") = [] {
+			go::errorf_site site;
+
+			auto first = go::interned_errorf(site, 0);
+			for (std::size_t i = 1; i <= go::errorf_site::capacity; i++)
+				go::interned_errorf(site, i);
+
+			auto again = go::interned_errorf(site, 0);
+			expect(again != first);
+			expect(again.message() == "0");
+		};
+
+		should("manipulators don't leak into later calls") = [] {
+			go::errorf_site site;
+
+			auto hex = go::interned_errorf(site, std::hex, 255);
+			auto dec = go::interned_errorf(site, 255);
+
+			expect(hex.message() == "ff") << "got" << hex.message();
+			expect(dec.message() == "255") << "got" << dec.message();
+		};
+
+		should("arguments formatting interned errors are supported") = [] {
+			go::errorf_site outer;
+			go::errorf_site inner;
+
+			auto err = go::interned_errorf(outer, "outer: ", nested_obj{&inner});
+			expect(err.message() == "outer: inner") << "got" << err.message();
+		};
+	};
+
 	return 0;
 }
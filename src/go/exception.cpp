@@ -0,0 +1,160 @@
+#include <go/exception.hpp>
+#include <go/error_chain.hpp>
+#include <go/error_code.hpp>
+
+#include <system_error>
+#include <vector>
+
+namespace go
+{
+    namespace
+    {
+        // A single exception of a nest, before it is turned into an error
+        struct caught
+        {
+            std::exception_ptr exception;
+            error converted;
+            std::string what;
+        };
+
+        // Converts a single exception of a nest. e is null for exceptions that
+        // don't derive from std::exception
+        auto convert(std::exception const* e, std::exception_ptr exception, std::exception_ptr& nested) -> caught
+        {
+            if (!e)
+            {
+                try
+                {
+                    std::rethrow_exception(exception);
+                }
+                catch (std::nested_exception const& n)
+                {
+                    nested = n.nested_ptr();
+                }
+                catch (...)
+                {
+                }
+
+                return {std::move(exception), {}, "unknown exception"};
+            }
+
+            if (auto n = dynamic_cast<std::nested_exception const*>(e))
+                nested = n->nested_ptr();
+
+            if (auto carrier = dynamic_cast<error_exception const*>(e))
+                return {std::move(exception), carrier->err(), carrier->what()};
+
+            if (auto system = dynamic_cast<std::system_error const*>(e))
+            {
+                error code = make_error<error_code>(system->code());
+
+                // system_error's what() is the user's prefix, if any, followed by the code's message
+                std::string what = system->what();
+                auto suffix = ": " + system->code().message();
+                if (what.size() > suffix.size() && what.compare(what.size() - suffix.size(), suffix.size(), suffix) == 0)
+                    code = wrap_error(std::move(code), what.substr(0, what.size() - suffix.size()));
+
+                return {std::move(exception), std::move(code), std::move(what)};
+            }
+
+            return {std::move(exception), {}, e->what()};
+        }
+
+        auto convert(std::exception_ptr exception, std::exception_ptr& nested) -> caught
+        {
+            try
+            {
+                std::rethrow_exception(exception);
+            }
+            catch (std::exception const& e)
+            {
+                return convert(&e, std::move(exception), nested);
+            }
+            catch (...)
+            {
+                return convert(nullptr, std::move(exception), nested);
+            }
+        }
+
+        // Builds the chain from the innermost exception of the nest
+        auto build(std::vector<caught>& nest) -> error
+        {
+            error result;
+            for (auto it = nest.rbegin(); it != nest.rend(); ++it)
+            {
+                // Converted errors keep their type unless they have to wrap a nested exception,
+                // then they are wrapped along with it
+                if (it->converted && !result)
+                {
+                    result = std::move(it->converted);
+                    continue;
+                }
+
+                result = make_error<error_caught>(std::move(it->exception), std::move(it->what), std::move(result),
+                    std::move(it->converted));
+            }
+
+            return result;
+        }
+
+        auto unroll(caught outer, std::exception_ptr nested) -> error
+        {
+            // The nest is unrolled iteratively, as it may be deep
+            std::vector<caught> nest;
+            nest.push_back(std::move(outer));
+
+            while (nested)
+            {
+                std::exception_ptr next;
+                nest.push_back(convert(std::move(nested), next));
+                nested = std::move(next);
+            }
+
+            return build(nest);
+        }
+    }
+
+    namespace detail
+    {
+        auto error_from_caught(std::exception const* e) -> error
+        {
+            std::exception_ptr nested;
+            auto outer = convert(e, std::current_exception(), nested);
+
+            // The common case of a single exception needs no rethrow
+            if (!nested)
+            {
+                if (outer.converted)
+                    return std::move(outer.converted);
+
+                return make_error<error_caught>(std::move(outer.exception), std::move(outer.what), error());
+            }
+
+            return unroll(std::move(outer), std::move(nested));
+        }
+    }
+
+    error_exception::error_exception(error err) :
+        err_(std::move(err)), what_(err_.message())
+    {}
+
+    auto error_exception::what() const noexcept -> const char*
+    {
+        return what_.c_str();
+    }
+
+    auto throw_error(error err) -> void
+    {
+        throw error_exception(std::move(err));
+    }
+
+    auto error_from_exception(std::exception_ptr exception) -> error
+    {
+        if (!exception)
+            return {};
+
+        std::exception_ptr nested;
+        auto outer = convert(std::move(exception), nested);
+        return unroll(std::move(outer), std::move(nested));
+    }
+}
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <go/error.hpp>
+
+#include <exception>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace go
+{
+    /*! \addtogroup predefined Predefined errors
+     * @{
+     */
+
+    /// Error data for `go::error_caught`, an exception converted by `go::catch_as_error`.
+    /*!
+     * The message is the exception's `what()`. Exceptions nested with
+     * `std::throw_with_nested` become the wrapped error, so the whole nest
+     * is an ordinary unwrap chain.
+     *
+     * An exception that converts to an error of its own, like a `go::error_exception`
+     * or a `std::system_error`, and has a nested exception wraps both errors, the
+     * converted one first, so that `go::is_error` and `go::as_error` find either.
+     */
+    struct error_caught_data : public error_interface
+    {
+        /// Initialized with the caught exception, its `what()`, the converted nested
+        /// exception and the error the exception itself converted to.
+        error_caught_data(std::exception_ptr exception, std::string what, error nested, error converted = {}) :
+            exception_(std::move(exception)), what_(std::move(what)), wrapped_{std::move(converted), std::move(nested)}
+        {}
+
+        /// Returns the caught exception, for example to rethrow it.
+        auto exception() const -> std::exception_ptr const&
+        {
+            return exception_;
+        }
+
+        /// Returns the error the exception itself converted to, if any.
+        auto converted() const -> error const&
+        {
+            return wrapped_[0];
+        }
+
+        /// Returns the converted nested exception, if there was one.
+        auto nested() const -> error const&
+        {
+            return wrapped_[1];
+        }
+
+        /// Returns the exception's `what()`.
+        auto message() const -> std::string override
+        {
+            return what_;
+        }
+
+        /// Returns the converted nested exception, unless the exception converted
+        /// to an error of its own.
+        auto unwrap() const -> error override
+        {
+            return wrapped_[0] ? error() : wrapped_[1];
+        }
+
+        /// Returns the converted error and the converted nested exception, if the
+        /// exception converted to an error of its own.
+        auto unwrap_span() const -> error_span override
+        {
+            return wrapped_[0] ? error_span(wrapped_, wrapped_[1] ? 2 : 1) : error_span();
+        }
+
+        /// Returns a copy of `unwrap_span`, made on the first call.
+        auto unwrap_multiple() const -> std::vector<error> const& override
+        {
+            return multiple_.get(unwrap_span());
+        }
+
+    private:
+        std::exception_ptr exception_;
+        std::string what_;
+
+        // The converted error and the converted nested exception
+        error wrapped_[2];
+        detail::unwrap_multiple_cache multiple_;
+    };
+
+    /// An exception converted into an error by `go::catch_as_error`.
+    using error_caught = error_of<error_caught_data>;
+
+    /*! @} */
+
+    /// \cond TEMPLATE_DETAILS
+    namespace detail
+    {
+        /// `go::error_from_exception` for the exception being handled, with e pointing
+        /// to it if it derives from std::exception. Avoids rethrowing it to find its type.
+        auto error_from_caught(std::exception const* e) -> error;
+    } // namespace detail
+    /// \endcond
+
+    /*! \addtogroup exceptions
+     * @{
+     */
+
+    /// Exception that carries a `go::error`, as thrown by `go::throw_error`.
+    /*!
+     * `what()` is the error's message, rendered when the exception is created.
+     * `go::catch_as_error` returns the carried error as-is, so an error survives
+     * a trip through code that only passes exceptions along.
+     */
+    class error_exception : public std::exception
+    {
+    public:
+        /// Carries err.
+        explicit error_exception(error err);
+
+        /// Returns the carried error.
+        auto err() const noexcept -> error const&
+        {
+            return err_;
+        }
+
+        /// Returns the carried error's message.
+        auto what() const noexcept -> const char* override;
+
+    private:
+        error err_;
+        std::string what_;
+    };
+
+    /// Throws err as a `go::error_exception`.
+    [[noreturn]] auto throw_error(error err) -> void;
+
+    /// Converts an exception into an error.
+    /*!
+     * - `go::error_exception` gives back the error it carries
+     * - `std::system_error` becomes a `go::error_code`, wrapped with `go::wrap_error`
+     *   by whatever `what()` adds in front of the code's message
+     * - other exceptions become a `go::error_caught` that keeps `what()`
+     *
+     * Nested exceptions become the wrapped errors of a `go::error_caught`, along
+     * with the error the outer exception converted to.
+     * A null pointer gives an empty error.
+     */
+    auto error_from_exception(std::exception_ptr exception) -> error;
+
+    /// Calls f and returns any exception it throws as an error.
+    /*!
+     * Refer to `go::error_from_exception` for how exceptions are converted.
+     *
+     * If f returns void, the result is an empty error on success. If f returns an error,
+     * that error is returned. Otherwise the result is a pair of f's result, value
+     * initialized if f threw, and the error:
+     *
+     * ```
+     * auto err = go::catch_as_error([&] { legacy.flush(); });
+     * auto [size, sizeErr] = go::catch_as_error([&] { return legacy.size(); });
+     * ```
+     */
+    template <class F>
+    auto catch_as_error(F&& f)
+    {
+        using result_type = std::invoke_result_t<F>;
+
+        if constexpr (std::is_void_v<result_type>)
+        {
+            try
+            {
+                std::invoke(std::forward<F>(f));
+                return error();
+            }
+            catch (std::exception const& e)
+            {
+                return detail::error_from_caught(&e);
+            }
+            catch (...)
+            {
+                return detail::error_from_caught(nullptr);
+            }
+        }
+        else if constexpr (std::is_convertible_v<result_type, error>)
+        {
+            try
+            {
+                return error(std::invoke(std::forward<F>(f)));
+            }
+            catch (std::exception const& e)
+            {
+                return detail::error_from_caught(&e);
+            }
+            catch (...)
+            {
+                return detail::error_from_caught(nullptr);
+            }
+        }
+        else
+        {
+            static_assert(std::is_default_constructible_v<result_type>,
+                "catch_as_error expects f's result to be default constructible");
+
+            try
+            {
+                return std::pair<result_type, error>(std::invoke(std::forward<F>(f)), error());
+            }
+            catch (std::exception const& e)
+            {
+                return std::pair<result_type, error>(result_type(), detail::error_from_caught(&e));
+            }
+            catch (...)
+            {
+                return std::pair<result_type, error>(result_type(), detail::error_from_caught(nullptr));
+            }
+        }
+    }
+
+    /*! @} */
+}
@@ -0,0 +1,142 @@
+#include <go/exception.hpp>
+#include <go/error_chain.hpp>
+#include <go/error_code.hpp>
+#include <go/errorf.hpp>
+#include <go/wrap.hpp>
+
+#include <boost/ut.hpp>
+using namespace boost::ut;
+
+#include <stdexcept>
+#include <system_error>
+
+int main()
+{
+	"catch_as_error"_test = [] {
+		should("successful calls return no error") = [] {
+			expect(go::catch_as_error([] {}) == false);
+			expect(go::catch_as_error([] { return go::error(); }) == false);
+
+			auto [value, err] = go::catch_as_error([] { return 42; });
+			expect(value == 42_i);
+			expect(err == false);
+		};
+
+		should("returned errors are passed through") = [] {
+			auto errReturned = go::errorf("returned");
+			expect(go::catch_as_error([&] { return errReturned; }) == errReturned);
+		};
+
+		should("system_error becomes error_code") = [] {
+			auto err = go::catch_as_error([] {
+				throw std::system_error(std::make_error_code(std::errc::no_such_file_or_directory), "opening config");
+			});
+
+			go::error_code code;
+			expect(go::as_error(err, code));
+			expect(code->code() == std::errc::no_such_file_or_directory);
+
+			go::error_frame frame;
+			expect(go::as_error(err, frame));
+			expect(frame->context() == "opening config");
+
+			auto bare = go::catch_as_error([] { throw std::system_error(std::make_error_code(std::errc::timed_out)); });
+			expect(go::error_cast<go::error_code>(bare) == bare);
+		};
+
+		should("other exceptions keep what()") = [] {
+			auto [value, err] = go::catch_as_error([]() -> int { throw std::runtime_error("disk on fire"); });
+			expect(value == 0_i);
+			expect(err.message() == "disk on fire");
+
+			go::error_caught caught;
+			expect(go::as_error(err, caught));
+
+			bool rethrown = false;
+			try
+			{
+				std::rethrow_exception(caught->exception());
+			}
+			catch (std::runtime_error const&)
+			{
+				rethrown = true;
+			}
+			expect(rethrown);
+
+			expect(go::catch_as_error([] { throw 42; }).message() == "unknown exception");
+		};
+
+		should("nested exceptions become an unwrap chain") = [] {
+			auto err = go::catch_as_error([] {
+				try
+				{
+					try
+					{
+						throw std::system_error(std::make_error_code(std::errc::connection_refused));
+					}
+					catch (...)
+					{
+						std::throw_with_nested(std::runtime_error("connecting to db"));
+					}
+				}
+				catch (...)
+				{
+					std::throw_with_nested(std::logic_error("loading user"));
+				}
+			});
+
+			expect(err.message() == "loading user");
+			expect(err.unwrap().message() == "connecting to db");
+
+			go::error_code code;
+			expect(go::as_error(err, code));
+			expect(code->code() == std::errc::connection_refused);
+		};
+
+		should("converted exceptions with nested ones keep their error") = [] {
+			auto errSentinel = go::errorf("sentinel");
+
+			auto err = go::catch_as_error([&] {
+				try
+				{
+					throw std::runtime_error("disk full");
+				}
+				catch (...)
+				{
+					std::throw_with_nested(go::error_exception(errSentinel));
+				}
+			});
+
+			expect(err.message() == "sentinel");
+			expect(go::is_error(err, errSentinel));
+
+			go::error_caught caught;
+			expect(go::as_error(err, caught));
+			expect(caught->converted() == errSentinel);
+			expect(caught->nested().message() == "disk full");
+			expect(err.unwrap_multiple().size() == 2_ul);
+		};
+	};
+
+	"throw_error"_test = [] {
+		should("errors survive a round trip") = [] {
+			auto errNotFound = go::errorf("not found");
+			auto wrapped = go::wrap_error(errNotFound, "looking up user");
+
+			auto err = go::catch_as_error([&] { go::throw_error(wrapped); });
+			expect(err == wrapped);
+			expect(go::is_error(err, errNotFound));
+
+			try
+			{
+				go::throw_error(wrapped);
+			}
+			catch (std::exception const& e)
+			{
+				expect(std::string(e.what()) == "looking up user: not found");
+			}
+		};
+	};
+
+	return 0;
+}
@@ -0,0 +1,278 @@
+#include <go/flatten.hpp>
+#include <go/memoize.hpp>
+#include <go/render.hpp>
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace go
+{
+    struct error_snapshot::state
+    {
+        std::vector<error_snapshot_node> nodes;
+        std::size_t typeCount = 0;
+        std::string messages;
+    };
+
+    auto error_snapshot::root() const -> error
+    {
+        return state_ ? state_->nodes.front().err : error();
+    }
+
+    auto error_snapshot::size() const noexcept -> std::size_t
+    {
+        return state_ ? state_->nodes.size() : 0;
+    }
+
+    auto error_snapshot::node(std::size_t index) const -> error_snapshot_node const&
+    {
+        return state_->nodes[index];
+    }
+
+    auto error_snapshot::nodes() const noexcept -> std::vector<error_snapshot_node> const&
+    {
+        static const std::vector<error_snapshot_node> empty;
+        return state_ ? state_->nodes : empty;
+    }
+
+    auto error_snapshot::type_count() const noexcept -> std::size_t
+    {
+        return state_ ? state_->typeCount : 0;
+    }
+
+    auto error_snapshot::message() const noexcept -> std::string_view
+    {
+        return state_ ? message(0) : std::string_view("<nil>");
+    }
+
+    auto error_snapshot::message(std::size_t index) const -> std::string_view
+    {
+        auto& node = state_->nodes[index];
+        return std::string_view(state_->messages).substr(node.message_offset, node.message_size);
+    }
+
+    namespace
+    {
+        // Sets layout and returns true if the message of the error at index is laid out
+        // around the messages of exactly the children it has in the snapshot
+        auto inline_layout(std::vector<error_snapshot_node> const& nodes, std::size_t index, message_layout& layout) -> bool
+        {
+            auto& node = nodes[index];
+            auto composite = dynamic_cast<composite_message_interface const*>(node.data);
+            if (!composite)
+                return false;
+
+            // Children that were skipped or cut by the traversal limits are missing
+            auto unwrapped = node.err.unwrap();
+            auto children = unwrapped ? error_span(&unwrapped, 1) : node.err.unwrap_span();
+            if (children.size() != node.child_count)
+                return false;
+
+            auto child = index + 1;
+            for (auto& expected : children)
+            {
+                if (static_cast<error_interface const*>(expected.operator->()) != nodes[child].data)
+                    return false;
+
+                child = nodes[child].subtree_end;
+            }
+
+            layout = composite->message_layout();
+            return true;
+        }
+
+        // Renders the messages of all nodes into messages and returns the offset and size of every one.
+        // Composite messages contain the messages of their children, which aren't rendered again.
+        auto render_messages(std::vector<error_snapshot_node> const& nodes, std::string& messages)
+            -> std::vector<std::pair<std::size_t, std::size_t>>
+        {
+            std::vector<std::pair<std::size_t, std::size_t>> ranges(nodes.size());
+
+            struct open_message
+            {
+                std::size_t index;
+                message_layout layout;
+                std::size_t nextChild;
+                std::size_t written;
+            };
+
+            // Nodes whose message doesn't contain the message of their parent
+            std::vector<std::size_t> regions{0};
+            std::vector<open_message> open;
+
+            // Returns true if the message is opened, to be finished once its children are written
+            auto begin = [&](std::size_t index) -> bool
+            {
+                ranges[index].first = messages.size();
+
+                message_layout layout;
+                if (inline_layout(nodes, index, layout))
+                {
+                    messages += layout.prefix;
+                    open.push_back({index, std::move(layout), index + 1, 0});
+                    return true;
+                }
+
+                append_message(messages, nodes[index].err);
+                ranges[index].second = messages.size() - ranges[index].first;
+
+                for (auto child = index + 1; child < nodes[index].subtree_end; child = nodes[child].subtree_end)
+                    regions.push_back(child);
+
+                return false;
+            };
+
+            while (!regions.empty())
+            {
+                auto region = regions.back();
+                regions.pop_back();
+                begin(region);
+
+                while (!open.empty())
+                {
+                    auto& top = open.back();
+                    if (top.written == nodes[top.index].child_count)
+                    {
+                        messages += top.layout.suffix;
+                        ranges[top.index].second = messages.size() - ranges[top.index].first;
+                        open.pop_back();
+
+                        if (!open.empty())
+                            messages += open.back().layout.after_each;
+
+                        continue;
+                    }
+
+                    if (top.written++ != 0)
+                        messages += top.layout.between;
+
+                    messages += top.layout.before_each;
+
+                    auto child = top.nextChild;
+                    top.nextChild = nodes[child].subtree_end;
+                    if (!begin(child))
+                        messages += open.back().layout.after_each;
+                }
+            }
+
+            return ranges;
+        }
+    }
+
+    auto flatten(error const& err, traversal_options const& options) -> error_snapshot
+    {
+        if (!err)
+            return {};
+
+        auto result = std::make_shared<error_snapshot::state>();
+        auto& nodes = result->nodes;
+
+        // A tree usually has few distinct types, so a linear search over pointers
+        // beats hashing
+        std::vector<std::type_info const*> types;
+        auto add = [&](error const& e, std::uint32_t parent, std::size_t depth) -> void
+        {
+            auto data = e.data().get();
+            auto& type = typeid(*data);
+
+            auto typeIndex = std::find(types.begin(), types.end(), &type) - types.begin();
+            if (typeIndex == static_cast<std::ptrdiff_t>(types.size()))
+                types.push_back(&type);
+
+            nodes.push_back({e, data, &type, static_cast<std::uint32_t>(typeIndex), parent,
+                static_cast<std::uint32_t>(depth), 0, 0, 0, 0});
+        };
+
+        // Mirrors detail::wrapping_impl::walk, so that the snapshot holds exactly
+        // the errors is_error and as_error would visit
+        struct open_node
+        {
+            std::uint32_t index;
+            std::size_t depth;
+            std::size_t nextChildId;
+        };
+
+        std::vector<open_node> open;
+        std::unique_ptr<std::unordered_set<error_interface const*>> seen;
+        bool exhausted = false;
+
+        add(err, error_snapshot_node::npos, 0);
+        open.push_back({0, 0, 0});
+
+        while (!open.empty())
+        {
+            auto& top = open.back();
+            auto const& parent = nodes[top.index];
+
+            error child;
+            if (!exhausted && top.depth < options.max_depth)
+            {
+                if (top.nextChildId == 0)
+                {
+                    child = parent.err.unwrap();
+                    if (child)
+                        top.nextChildId = std::numeric_limits<std::size_t>::max();
+                }
+
+                if (!child)
+                {
+                    auto children = parent.err.unwrap_span();
+                    while (!child && top.nextChildId < children.size())
+                        child = children[top.nextChildId++];
+                }
+            }
+
+            if (!child)
+            {
+                nodes[top.index].subtree_end = static_cast<std::uint32_t>(nodes.size());
+                open.pop_back();
+                continue;
+            }
+
+            auto depth = top.depth + 1;
+            if (depth > options.cycle_check_depth)
+            {
+                if (!seen)
+                    seen = std::make_unique<std::unordered_set<error_interface const*>>();
+
+                if (!seen->insert(child.data().get()).second)
+                    continue;
+            }
+
+            if (nodes.size() >= options.max_nodes || nodes.size() >= error_snapshot_node::npos)
+            {
+                exhausted = true;
+                continue;
+            }
+
+            auto parentIndex = top.index;
+            nodes[parentIndex].child_count++;
+
+            add(child, parentIndex, depth);
+            open.push_back({static_cast<std::uint32_t>(nodes.size() - 1), depth, 0});
+        }
+
+        result->typeCount = types.size();
+
+        // Offsets are 32 bit, messages that end past the limit are left empty
+        constexpr std::size_t maxOffset = std::numeric_limits<std::uint32_t>::max();
+
+        auto ranges = render_messages(nodes, result->messages);
+        for (std::size_t i = 0; i < nodes.size(); i++)
+        {
+            auto [offset, size] = ranges[i];
+            if (offset + size > maxOffset)
+                continue;
+
+            nodes[i].message_offset = static_cast<std::uint32_t>(offset);
+            nodes[i].message_size = static_cast<std::uint32_t>(size);
+        }
+
+        if (result->messages.size() > maxOffset)
+            result->messages.resize(maxOffset);
+
+        error_snapshot snapshot;
+        snapshot.state_ = std::move(result);
+        return snapshot;
+    }
+}
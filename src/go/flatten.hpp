@@ -0,0 +1,223 @@
+#pragma once
+
+#include <go/error.hpp>
+#include <go/error_cast.hpp>
+#include <go/wrap.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+#include <vector>
+
+namespace go
+{
+    /*! \addtogroup wrapping
+     * @{
+     */
+
+    /// A single error of a `go::error_snapshot`.
+    struct error_snapshot_node
+    {
+        /// Marks the missing parent of the root.
+        static constexpr std::uint32_t npos = std::numeric_limits<std::uint32_t>::max();
+
+        /// The error itself.
+        error err;
+
+        /// The error's data, which err keeps alive.
+        error_interface const* data;
+
+        /// Dynamic type of the error's data.
+        std::type_info const* type;
+
+        /// Index of the type among the distinct types of the snapshot.
+        std::uint32_t type_index;
+
+        /// Index of the error that wraps this one, or npos for the root.
+        std::uint32_t parent;
+
+        /// Number of errors between the root and this one.
+        std::uint32_t depth;
+
+        /// Number of wrapped errors in the snapshot. The first one directly
+        /// follows this error, the next ones follow the subtree of the previous.
+        std::uint32_t child_count;
+
+        /// Index past the last error of this error's subtree.
+        std::uint32_t subtree_end;
+
+        /// Offset of the message in the snapshot's message buffer. Composite
+        /// messages contain the messages of the errors they wrap.
+        std::uint32_t message_offset;
+
+        /// Size of the message. Zero for messages that end past 4 GiB into the buffer.
+        std::uint32_t message_size;
+    };
+
+    /// Immutable, flattened copy of an error tree, as created by `go::flatten`.
+    /*!
+     * The tree is laid out in a contiguous array in the order `go::is_error` visits
+     * errors, with the distinct data types and the messages of all errors computed
+     * once. `go::is_error` and `go::as_error` on a snapshot check each distinct type
+     * once per query and then scan the array, instead of walking the tree through
+     * virtual `unwrap` calls and casting every error.
+     *
+     * Copies share the same immutable state, so a snapshot is cheap to pass around
+     * and safe to query from several threads at once. The snapshot keeps the errors
+     * of the tree alive.
+     */
+    class error_snapshot
+    {
+    public:
+        /// Creates an empty snapshot.
+        error_snapshot() = default;
+
+        /// False for the snapshot of an empty error.
+        explicit operator bool() const noexcept
+        {
+            return state_ != nullptr;
+        }
+
+        /// Returns the error the snapshot was created from.
+        auto root() const -> error;
+
+        /// Returns the number of errors in the snapshot.
+        auto size() const noexcept -> std::size_t;
+
+        /// Returns the error at index in traversal order. The root has index zero.
+        auto node(std::size_t index) const -> error_snapshot_node const&;
+
+        /// Returns all the errors in traversal order.
+        auto nodes() const noexcept -> std::vector<error_snapshot_node> const&;
+
+        /// Returns the number of distinct data types in the snapshot.
+        auto type_count() const noexcept -> std::size_t;
+
+        /// Returns the root's message, or "<nil>" for an empty snapshot.
+        auto message() const noexcept -> std::string_view;
+
+        /// Returns the message of the error at index.
+        auto message(std::size_t index) const -> std::string_view;
+
+    private:
+        struct state;
+
+        std::shared_ptr<state const> state_;
+
+        friend auto flatten(error const& err, traversal_options const& options) -> error_snapshot;
+    };
+
+    /// Flattens err's tree into an immutable `go::error_snapshot`.
+    /*!
+     * The errors visited follow options the same way `go::is_error` would visit them,
+     * so queries on the snapshot give the same answers as on err.
+     *
+     * The messages share a single buffer. Errors that implement
+     * `go::composite_message_interface` are rendered piece by piece, so that their
+     * message contains the messages of the errors they wrap, and rendering the root
+     * renders all of them once. The errors wrapped by other errors are rendered
+     * again on their own. It pays off for errors that are queried many times.
+     */
+    auto flatten(error const& err, traversal_options const& options = {}) -> error_snapshot;
+
+    /// \cond TEMPLATE_DETAILS
+    namespace detail
+    {
+        /// Calls can_match once per distinct type of the snapshot and match for every
+        /// error whose type passed, in traversal order, until match returns true.
+        template <class CanMatch, class Match>
+        auto scan_snapshot(error_snapshot const& snapshot, CanMatch&& can_match, Match&& match) -> bool
+        {
+            constexpr std::size_t max_mask_types = 64;
+
+            auto& nodes = snapshot.nodes();
+            if (snapshot.type_count() > max_mask_types)
+            {
+                for (auto& node : nodes)
+                {
+                    if (can_match(node) && match(node))
+                        return true;
+                }
+
+                return false;
+            }
+
+            // The type check only depends on the dynamic type, so it is done for the
+            // first error of every type
+            std::uint64_t checked = 0;
+            std::uint64_t passed = 0;
+            for (auto& node : nodes)
+            {
+                auto bit = std::uint64_t(1) << node.type_index;
+                if (!(checked & bit))
+                {
+                    checked |= bit;
+                    if (can_match(node))
+                        passed |= bit;
+                }
+
+                if ((passed & bit) && match(node))
+                    return true;
+            }
+
+            return false;
+        }
+    } // namespace detail
+    /// \endcond
+
+    /// `go::is_error` on a snapshot. Gives the same answer as on the flattened error.
+    template <class Against>
+    auto is_error(error_snapshot const& snapshot, error_of<Against> const& target) -> bool
+    {
+        if (!snapshot || !target)
+            return !snapshot && !target;
+
+        auto targetData = static_cast<error_interface const*>(target.data().get());
+        for (auto& node : snapshot.nodes())
+        {
+            if (node.data == targetData)
+                return true;
+        }
+
+        using interface = is_interface<error_of<Against>>;
+        return detail::scan_snapshot(snapshot,
+            [](error_snapshot_node const& node) { return dynamic_cast<interface const*>(node.data) != nullptr; },
+            [&](error_snapshot_node const& node)
+            {
+                return dynamic_cast<interface const*>(node.data)->is(target);
+            });
+    }
+
+    /// `go::as_error` on a snapshot. Finds the same error as on the flattened error.
+    template <class To>
+    auto as_error(error_snapshot const& snapshot, To& target) -> bool
+    {
+        static_assert(!std::is_const_v<To>, "as_error modifies target and expects it to be non-const");
+        static_assert(std::is_convertible_v<To, bool>, "as_error expects target to be convertible to bool");
+        static_assert(std::is_class_v<std::remove_pointer_t<std::remove_cv_t<To>>> || std::is_same_v<std::remove_cv_t<To>, void*>, "as_error expects target's type to be viable dynamic_cast target");
+
+        using interface = as_interface<To>;
+        return detail::scan_snapshot(snapshot,
+            [](error_snapshot_node const& node)
+            {
+                return static_cast<bool>(error_cast<To>(node.err))
+                    || dynamic_cast<interface const*>(node.data) != nullptr;
+            },
+            [&](error_snapshot_node const& node)
+            {
+                if (auto candidate = error_cast<To>(node.err))
+                {
+                    target = candidate;
+                    return true;
+                }
+
+                dynamic_cast<interface const*>(node.data)->as(target);
+                return true;
+            });
+    }
+
+    /*! @} */
+}
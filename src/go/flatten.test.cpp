@@ -0,0 +1,161 @@
+#include <go/flatten.hpp>
+#include <go/error_chain.hpp>
+#include <go/error_code.hpp>
+#include <go/errorf.hpp>
+#include <go/multi_error.hpp>
+
+#include <boost/ut.hpp>
+using namespace boost::ut;
+
+#include <thread>
+
+struct error_port_data : public go::error_interface
+{
+	int port;
+
+	explicit error_port_data(int port) : port(port) {}
+
+	std::string message() const override { return "port " + std::to_string(port) + " is busy"; }
+};
+
+using error_port = go::error_of<error_port_data>;
+
+auto errNotFound = go::errorf("not found");
+
+struct error_legacy_data : public go::error_interface, public go::is_interface<go::error>
+{
+	std::string message() const override { return "legacy not found"; }
+
+	bool is(go::error const& target) const override
+	{
+		return target == errNotFound;
+	}
+};
+
+int main()
+{
+	"flatten"_test = [] {
+		should("nodes are laid out in traversal order") = [] {
+			auto port = go::make_error<error_port>(8080);
+			auto err = go::append_error(go::wrap_error(port, "listening"), go::errorf("name is empty"));
+			auto snapshot = go::flatten(err);
+
+			expect(snapshot.size() == 4_ul);
+			expect(snapshot.root() == err);
+			expect(snapshot.message() == err.message());
+			expect(snapshot.message(1) == "listening: port 8080 is busy");
+			expect(snapshot.message(2) == "port 8080 is busy");
+
+			auto& root = snapshot.node(0);
+			expect(root.parent == go::error_snapshot_node::npos);
+			expect(root.child_count == 2_u);
+			expect(root.subtree_end == 4_u);
+
+			auto& frame = snapshot.node(1);
+			expect(frame.parent == 0_u);
+			expect(frame.subtree_end == 3_u);
+			expect(snapshot.node(frame.subtree_end).parent == 0_u);
+
+			expect(snapshot.node(2).err == port);
+			expect(snapshot.node(2).depth == 2_u);
+			expect(*snapshot.node(2).type == typeid(error_port_data));
+			expect(snapshot.type_count() == 4_ul);
+		};
+
+		should("queries match the flattened error") = [] {
+			auto port = go::make_error<error_port>(8080);
+			auto err = go::wrap_error(go::append_error(go::errorf("a"), port, go::make_error<go::error_of<error_legacy_data>>()), "starting");
+			auto snapshot = go::flatten(err);
+
+			expect(go::is_error(snapshot, port));
+			expect(go::is_error(snapshot, errNotFound));
+			expect(go::is_error(snapshot, go::errorf("a")) == false);
+
+			error_port found;
+			expect(go::as_error(snapshot, found));
+			expect(found == port);
+
+			error_port_data* data = nullptr;
+			expect(go::as_error(snapshot, data));
+			expect(data == port.data().get());
+
+			go::error_code code;
+			expect(go::as_error(snapshot, code) == false);
+		};
+
+		should("empty errors give empty snapshots") = [] {
+			auto snapshot = go::flatten(go::error());
+
+			expect(static_cast<bool>(snapshot) == false);
+			expect(snapshot.size() == 0_ul);
+			expect(snapshot.message() == "<nil>");
+			expect(go::is_error(snapshot, go::error()));
+			expect(go::is_error(snapshot, errNotFound) == false);
+		};
+
+		should("traversal options are respected") = [] {
+			auto err = go::errorf("root");
+			for (int i = 0; i < 10; i++)
+				err = go::wrap_error(err, "frame");
+
+			go::traversal_options opts;
+			opts.max_depth = 3;
+			expect(go::flatten(err, opts).size() == 4_ul);
+
+			opts = {};
+			opts.max_nodes = 5;
+			expect(go::flatten(err, opts).size() == 5_ul);
+		};
+
+		should("messages share the text of the errors they wrap") = [] {
+			auto err = go::errorf("root");
+			for (int i = 0; i < 1000; i++)
+				err = go::wrap_error(err, "frame");
+
+			err = go::append_error(err, go::join_errors(go::errorf("a"), go::make_error<error_port>(80)));
+			auto snapshot = go::flatten(err);
+
+			auto root = snapshot.message();
+			for (std::size_t i = 0; i < snapshot.size(); i++)
+			{
+				auto msg = snapshot.message(i);
+				expect(msg == snapshot.node(i).err.message());
+				expect(msg.data() >= root.data() && msg.data() + msg.size() <= root.data() + root.size());
+			}
+		};
+
+		should("messages of cut trees are rendered in full") = [] {
+			auto err = go::wrap_error(go::append_error(go::wrap_error(go::errorf("a"), "b"), go::errorf("c")), "d");
+
+			go::traversal_options opts;
+			opts.max_depth = 2;
+			auto snapshot = go::flatten(err, opts);
+
+			expect(snapshot.size() == 4_ul);
+			for (std::size_t i = 0; i < snapshot.size(); i++)
+				expect(snapshot.message(i) == snapshot.node(i).err.message());
+		};
+
+		should("snapshots can be shared across threads") = [] {
+			auto port = go::make_error<error_port>(8080);
+			auto snapshot = go::flatten(go::wrap_error(port, "listening"));
+
+			std::atomic<int> matches{0};
+			std::vector<std::thread> threads;
+			for (int t = 0; t < 4; t++)
+			{
+				threads.emplace_back([snapshot, port, &matches] {
+					for (int i = 0; i < 1000; i++)
+						matches += go::is_error(snapshot, port) ? 1 : 0;
+				});
+			}
+
+			for (auto& thread : threads)
+				thread.join();
+
+			expect(matches.load() == 4000_i);
+		};
+	};
+
+	return 0;
+}
@@ -103,9 +103,119 @@
  */
 /*! @} */
 
+/*! \defgroup fields Structured fields
+ * Errors can carry typed key/value fields next to their message, so that logging
+ * code doesn't need to format context into `message()` and parse it back out.
+ *
+ * ```
+ * err = go::with_fields(err, go::field("host", host), go::field("attempt", attempt));
+ *
+ * for (auto& f : go::fields(err))
+ *     std::cout << f.key << '\n';
+ *
+ * go::logfmt_sink(std::clog).write(err);
+ * ```
+ * @{
+ */
+/*! @} */
+
+/*! \defgroup exceptions Exceptions
+ * Adapters for the boundaries between code that throws and code that returns errors.
+ *
+ * ```
+ * auto err = go::catch_as_error([&] { legacy.flush(); });
+ *
+ * if (err)
+ *     go::throw_error(go::wrap_error(err, "flushing"));
+ * ```
+ * @{
+ */
+/*! @} */
+
+/*! \defgroup tracing Tracing
+ * Errors can record where they were created, to make it easier to find the origin
+ * of an error that surfaced at the top of a request.
+ *
+ * ```
+ * static go::trace_sampler site(100);
+ * auto err = go::make_traced_error<error_parse>(site, line);
+ *
+ * if (auto trace = go::find_stack_trace(err))
+ *     std::cerr << trace->to_string();
+ * ```
+ * @{
+ */
+/*! @} */
+
+/*! \defgroup reporting Reporting
+ * Building blocks for getting errors from the threads that produce them
+ * to logs and other reporting backends.
+ * @{
+ */
+/*! @} */
+
+/*! \defgroup hashing Hashing
+ * Errors compare by identity with `operator==`. Hashing and value equality compare
+ * whole error trees by their values instead, so that errors can be used as keys
+ * when caching or deduplicating failure results.
+ *
+ * ```
+ * std::unordered_map<go::error, int, go::error_hash, go::error_value_equal> failures;
+ * failures[err]++;
+ * ```
+ * @{
+ */
+/*! @} */
+
+/*! \defgroup serialization Serialization
+ * Error trees can be encoded into a compact binary form and decoded in another
+ * process. Sentinels and custom error types survive the trip when both sides
+ * register them under the same IDs.
+ *
+ * ```
+ * std::string buffer;
+ * go::encode_error(err, buffer);
+ *
+ * auto [decoded, decodeErr] = go::decode_error(buffer);
+ * ```
+ * @{
+ */
+/*! @} */
+
+/*! \defgroup instrumentation Instrumentation
+ * Opt-in counters that describe how an application uses errors. They are compiled
+ * in only when the library and its users are built with `GOERROR_ENABLE_METRICS`
+ * or `GOERROR_ENABLE_LIVE_TRACKING` (CMake flags of the same name), otherwise
+ * they cost nothing.
+ * @{
+ */
+/*! @} */
+
 #include <go/error.hpp>
 #include <go/error_string.hpp>
 #include <go/error_code.hpp>
 #include <go/error_cast.hpp>
+#include <go/error_set.hpp>
+#include <go/out_of_memory.hpp>
+#include <go/memoize.hpp>
+#include <go/render.hpp>
 #include <go/errorf.hpp>
 #include <go/wrap.hpp>
+#include <go/error_chain.hpp>
+#include <go/flatten.hpp>
+#include <go/multi_error.hpp>
+#include <go/error_fields.hpp>
+#include <go/exception.hpp>
+#include <go/stack_trace.hpp>
+#include <go/source_location.hpp>
+#include <go/metrics.hpp>
+#include <go/live_errors.hpp>
+#include <go/serialize.hpp>
+#include <go/json.hpp>
+#include <go/error_channel.hpp>
+#include <go/error_column.hpp>
+#include <go/error_table.hpp>
+#include <go/dedup_sink.hpp>
+#include <go/hash.hpp>
+#include <go/reclaim.hpp>
+#include <go/parallel.hpp>
@@ -0,0 +1,241 @@
+#include <go/hash.hpp>
+#include <go/error_code.hpp>
+#include <go/error_string.hpp>
+
+#include <functional>
+#include <string_view>
+#include <typeinfo>
+#include <vector>
+
+namespace go
+{
+    namespace
+    {
+        using detail::hash_combine;
+
+        // Returns either the single wrapped error or the multiple ones
+        struct children
+        {
+            error single;
+            error_span multiple;
+
+            explicit children(error const& err) :
+                single(err.unwrap())
+            {
+                if (!single)
+                    multiple = err.unwrap_span();
+            }
+
+            auto size() const -> std::size_t
+            {
+                return single ? 1 : multiple.size();
+            }
+
+            auto operator[](std::size_t i) const -> error const&
+            {
+                return single ? single : multiple[i];
+            }
+        };
+    }
+
+    namespace detail
+    {
+        struct hash_impl
+        {
+            // Predefined leaf errors are compared by value without implementing
+            // hashable_interface, so they don't carry its vtable and cache
+            static auto is_string(error_interface const& data) -> bool
+            {
+                return typeid(data) == typeid(error_string_data);
+            }
+
+            static auto is_code(error_interface const& data) -> bool
+            {
+                return typeid(data) == typeid(error_code_data);
+            }
+
+            // Returns false if data is compared by identity
+            static auto own_hash(error_interface const& data, hashable_interface const* hashable, std::size_t& hash) -> bool
+            {
+                if (hashable)
+                    hash = hashable->hash();
+                else if (is_string(data))
+                    hash = std::hash<std::string_view>()(static_cast<error_string_data const&>(data).msg);
+                else if (is_code(data))
+                    hash = std::hash<std::error_code>()(static_cast<error_code_data const&>(data).code());
+                else
+                    return false;
+
+                return true;
+            }
+
+            // Expects lhs and rhs to have the same dynamic type
+            static auto own_equals(error_interface const& lhs, error_interface const& rhs) -> bool
+            {
+                if (auto hashable = dynamic_cast<hashable_interface const*>(&lhs))
+                    return hashable->equals(rhs);
+
+                if (is_string(lhs))
+                    return static_cast<error_string_data const&>(lhs).msg == static_cast<error_string_data const&>(rhs).msg;
+
+                if (is_code(lhs))
+                    return static_cast<error_code_data const&>(lhs).code() == static_cast<error_code_data const&>(rhs).code();
+
+                return false;
+            }
+
+            static auto cacheable(hashable_interface const* h) -> bool
+            {
+                // The predefined leaves never change
+                return !h || h->tree_hash_cacheable();
+            }
+
+            static auto cached(hashable_interface const& h) -> std::size_t
+            {
+                return h.tree_hash_cacheable() ? h.treeHash_.load(std::memory_order_relaxed) : 0;
+            }
+
+            static auto store(hashable_interface const& h, std::size_t value) -> void
+            {
+                h.treeHash_.store(value, std::memory_order_relaxed);
+            }
+        };
+    }
+
+    auto error_hash::operator()(error const& err) const -> std::size_t
+    {
+        struct open_node
+        {
+            error err;
+            hashable_interface const* hashable;
+            children kids;
+            std::size_t next;
+            std::size_t hash;
+
+            // False once an error of the tree may change its value
+            bool cacheable;
+        };
+
+        std::vector<open_node> stack;
+        std::size_t result = 0;
+
+        // Returns true if the hash of err is known without visiting its children, whose
+        // values then never change
+        auto begin = [&](error const& node, std::size_t& hash) -> bool
+        {
+            auto data = node.operator->();
+            if (!data)
+            {
+                hash = 0;
+                return true;
+            }
+
+            auto hashable = dynamic_cast<hashable_interface const*>(data);
+            if (hashable)
+            {
+                if (auto cached = detail::hash_impl::cached(*hashable))
+                {
+                    hash = cached;
+                    return true;
+                }
+            }
+
+            std::size_t own;
+            if (!detail::hash_impl::own_hash(*data, hashable, own))
+            {
+                hash = std::hash<void const*>()(data);
+                return true;
+            }
+
+            // Within a binary each type has a single type_info
+            auto seed = hash_combine(std::hash<void const*>()(&typeid(*data)), own);
+            stack.push_back({node, hashable, children(node), 0, seed, detail::hash_impl::cacheable(hashable)});
+            return false;
+        };
+
+        if (begin(err, result))
+            return result;
+
+        while (!stack.empty())
+        {
+            auto& top = stack.back();
+            if (top.next < top.kids.size())
+            {
+                // Copied, as begin may move the stack
+                auto child = top.kids[top.next];
+                top.next++;
+
+                std::size_t hash;
+                if (begin(child, hash))
+                    stack.back().hash = hash_combine(stack.back().hash, hash);
+
+                continue;
+            }
+
+            auto hash = hash_combine(top.hash, top.kids.size());
+            if (hash == 0)
+                hash = 1;
+
+            // A wrapper of an error that may change is hashed again every time
+            auto cacheable = top.cacheable;
+            if (cacheable && top.hashable)
+                detail::hash_impl::store(*top.hashable, hash);
+
+            stack.pop_back();
+
+            if (stack.empty())
+                result = hash;
+            else
+            {
+                stack.back().hash = hash_combine(stack.back().hash, hash);
+                stack.back().cacheable = stack.back().cacheable && cacheable;
+            }
+        }
+
+        return result;
+    }
+
+    auto error_value_equal::operator()(error const& lhs, error const& rhs) const -> bool
+    {
+        std::vector<std::pair<error, error>> pending;
+        pending.emplace_back(lhs, rhs);
+
+        while (!pending.empty())
+        {
+            auto [a, b] = std::move(pending.back());
+            pending.pop_back();
+
+            auto aData = a.data().get();
+            auto bData = b.data().get();
+            if (aData == bData)
+                continue;
+
+            if (!aData || !bData || typeid(*aData) != typeid(*bData))
+                return false;
+
+            // Different cached hashes of whole trees settle it right away
+            auto aHashable = dynamic_cast<hashable_interface const*>(aData);
+            auto bHashable = dynamic_cast<hashable_interface const*>(bData);
+            if (aHashable && bHashable)
+            {
+                auto aCached = detail::hash_impl::cached(*aHashable);
+                auto bCached = detail::hash_impl::cached(*bHashable);
+                if (aCached != 0 && bCached != 0 && aCached != bCached)
+                    return false;
+            }
+
+            if (!detail::hash_impl::own_equals(*aData, *bData))
+                return false;
+
+            children aKids(a);
+            children bKids(b);
+            if (aKids.size() != bKids.size())
+                return false;
+
+            for (std::size_t i = aKids.size(); i-- > 0;)
+                pending.emplace_back(aKids[i], bKids[i]);
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <go/error.hpp>
+
+#include <atomic>
+#include <cstddef>
+
+namespace go
+{
+    /// \cond TEMPLATE_DETAILS
+    namespace detail
+    {
+        struct hash_impl;
+
+        /// Mixes value into seed, order-dependently.
+        inline auto hash_combine(std::size_t seed, std::size_t value) noexcept -> std::size_t
+        {
+            return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+        }
+    }
+    /// \endcond
+
+    /*! \addtogroup hashing Hashing
+     * @{
+     */
+
+    /// Implemented by error data that can be compared by value.
+    /*!
+     * Only the error's own value takes part: `go::error_hash` and `go::error_value_equal`
+     * combine it with the errors it wraps. `go::error_string` and `go::error_code` are
+     * compared by value without implementing it, other errors that don't implement the
+     * interface are compared by identity, the same way `operator==` compares them.
+     */
+    struct hashable_interface
+    {
+        hashable_interface() = default;
+
+        // The cached hash belongs to a single error instance
+        hashable_interface(hashable_interface const&) noexcept {}
+        auto operator=(hashable_interface const&) noexcept -> hashable_interface& { return *this; }
+
+        /// Returns the hash of the error's own value.
+        virtual auto hash() const noexcept -> std::size_t = 0;
+
+        /// Returns true if other, which has the same dynamic type, has an equal own value.
+        virtual auto equals(error_interface const& other) const noexcept -> bool = 0;
+
+        virtual ~hashable_interface() noexcept = default;
+
+    protected:
+        /// Returns true if neither the value nor the list of wrapped errors ever change.
+        /// `go::error_hash` caches the hash of the tree in the error if this holds for
+        /// every error of the tree, so wrappers of changing errors are hashed again.
+        virtual auto tree_hash_cacheable() const noexcept -> bool
+        {
+            return false;
+        }
+
+    private:
+        mutable std::atomic<std::size_t> treeHash_{0};
+
+        friend struct detail::hash_impl;
+    };
+
+    /// Hashes errors by value, combining the values of their whole tree.
+    /*!
+     * Consistent with `go::error_value_equal`, so errors can be used as keys of
+     * unordered containers, for example to cache or deduplicate failure results:
+     *
+     * ```
+     * std::unordered_map<go::error, int, go::error_hash, go::error_value_equal> counts;
+     * ```
+     *
+     * Predefined wrappers remember the hash of their tree unless it contains an error
+     * whose value may change, so hashing a deep chain again costs a single lookup.
+     */
+    struct error_hash
+    {
+        /// Returns the hash of err's tree. The empty error hashes to zero.
+        auto operator()(error const& err) const -> std::size_t;
+    };
+
+    /// Compares errors by value.
+    /*!
+     * Errors are equal when they are the same error, or when they have the same data
+     * type, equal values according to `go::hashable_interface` and equal wrapped errors
+     * in the same order.
+     *
+     * Note that this makes `go::error_string` sentinels with the same message equal,
+     * which `operator==` and `go::is_error` would tell apart.
+     */
+    struct error_value_equal
+    {
+        /// Returns true if lhs and rhs are equal by value.
+        auto operator()(error const& lhs, error const& rhs) const -> bool;
+    };
+
+    /*! @} */
+}
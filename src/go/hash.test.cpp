@@ -0,0 +1,139 @@
+#include <go/hash.hpp>
+#include <go/error_chain.hpp>
+#include <go/error_code.hpp>
+#include <go/error_fields.hpp>
+#include <go/errorf.hpp>
+#include <go/multi_error.hpp>
+
+#include <boost/ut.hpp>
+using namespace boost::ut;
+
+#include <string>
+#include <unordered_map>
+
+struct error_opaque_data : public go::error_interface
+{
+	std::string message() const override { return "opaque"; }
+};
+
+// Compared by a value that changes after the error was created
+struct error_counter_data : public go::error_interface, public go::hashable_interface
+{
+	std::string message() const override { return "count " + std::to_string(count); }
+	std::size_t hash() const noexcept override { return static_cast<std::size_t>(count); }
+
+	bool equals(go::error_interface const& other) const noexcept override
+	{
+		return count == static_cast<error_counter_data const&>(other).count;
+	}
+
+	int count = 0;
+};
+
+const go::error_hash hash;
+const go::error_value_equal equal;
+
+int main()
+{
+	"error_hash"_test = [] {
+		should("errors with equal values are equal") = [] {
+			auto a = go::wrap_error(go::errorf("refused"), "connecting");
+			auto b = go::wrap_error(go::errorf("refused"), "connecting");
+
+			expect(a != b);
+			expect(equal(a, b));
+			expect(hash(a) == hash(b));
+
+			auto ec = std::make_error_code(std::errc::timed_out);
+			expect(equal(go::make_error<go::error_code>(ec), go::make_error<go::error_code>(ec)));
+			expect(hash(go::make_error<go::error_code>(ec)) == hash(go::make_error<go::error_code>(ec)));
+		};
+
+		should("different values or shapes are not equal") = [] {
+			auto root = go::errorf("refused");
+
+			expect(equal(go::errorf("a"), go::errorf("b")) == false);
+			expect(equal(root, go::wrap_error(root, "connecting")) == false);
+			expect(equal(go::wrap_error(root, "a"), go::wrap_error(root, "b")) == false);
+			expect(hash(go::wrap_error(root, "a")) != hash(go::wrap_error(root, "b")));
+			expect(equal(root, go::error()) == false);
+			expect(equal(go::error(), go::error()));
+			expect(hash(go::error()) == 0_ul);
+
+			auto ec = std::make_error_code(std::errc::timed_out);
+			expect(equal(go::make_error<go::error_code>(ec), go::errorf(ec.message())) == false);
+		};
+
+		should("fields and lists are compared by value") = [] {
+			auto a = go::with_fields(go::errorf("failed"), go::field("host", "db"), go::field("attempt", 3));
+			auto b = go::with_fields(go::errorf("failed"), go::field("host", "db"), go::field("attempt", 3));
+			auto c = go::with_fields(go::errorf("failed"), go::field("host", "db"), go::field("attempt", 4));
+
+			expect(equal(a, b));
+			expect(hash(a) == hash(b));
+			expect(equal(a, c) == false);
+
+			auto listA = go::append_error(go::errorf("x"), go::errorf("y"));
+			auto listB = go::append_error(go::errorf("x"), go::errorf("y"));
+			auto listC = go::append_error(go::errorf("y"), go::errorf("x"));
+
+			expect(equal(listA, listB));
+			expect(hash(listA) == hash(listB));
+			expect(equal(listA, listC) == false);
+			expect(equal(listA, go::append_error(go::errorf("x"))) == false);
+		};
+
+		should("errors without values are compared by identity") = [] {
+			auto opaque = go::make_error<go::error_of<error_opaque_data>>();
+
+			expect(equal(opaque, opaque));
+			expect(equal(opaque, go::make_error<go::error_of<error_opaque_data>>()) == false);
+
+			expect(equal(go::wrap_error(opaque, "reading"), go::wrap_error(opaque, "reading")));
+			expect(hash(go::wrap_error(opaque, "reading")) == hash(go::wrap_error(opaque, "reading")));
+		};
+
+		should("deep chains are hashed once") = [] {
+			auto err = go::errorf("root");
+			for (int i = 0; i < 10000; i++)
+				err = go::wrap_error(err, "frame");
+
+			auto first = hash(err);
+			expect(hash(err) == first);
+			expect(hash(go::wrap_error(err, "one more")) != first);
+
+			auto other = go::errorf("root");
+			for (int i = 0; i < 10000; i++)
+				other = go::wrap_error(other, "frame");
+
+			expect(equal(err, other));
+		};
+
+		should("wrappers of changing errors are hashed again") = [] {
+			auto counter = go::make_error<go::error_of<error_counter_data>>();
+			auto err = go::with_fields(go::wrap_error(counter, "counting"), go::field("host", "db"));
+
+			auto before = hash(err);
+			counter->count++;
+			expect(hash(err) != before);
+
+			auto same = go::make_error<go::error_of<error_counter_data>>();
+			same->count = 1;
+			expect(hash(err) == hash(go::with_fields(go::wrap_error(same, "counting"), go::field("host", "db"))));
+		};
+
+		should("errors can be used as keys") = [] {
+			std::unordered_map<go::error, int, go::error_hash, go::error_value_equal> counts;
+
+			for (int i = 0; i < 3; i++)
+				counts[go::wrap_error(go::errorf("refused"), "connecting")]++;
+
+			counts[go::wrap_error(go::errorf("refused"), "reading")]++;
+
+			expect(counts.size() == 2_ul);
+			expect(counts[go::wrap_error(go::errorf("refused"), "connecting")] == 3_i);
+		};
+	};
+
+	return 0;
+}
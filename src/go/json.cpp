@@ -0,0 +1,272 @@
+#include <go/json.hpp>
+#include <go/error_chain.hpp>
+#include <go/error_code.hpp>
+#include <go/render.hpp>
+#include <go/detail/demangle.hpp>
+
+#include <memory>
+#include <typeinfo>
+#include <unordered_set>
+#include <vector>
+
+namespace go
+{
+    namespace
+    {
+        // Streamed output is handed to the stream in chunks of about this size
+        constexpr std::size_t flush_threshold = 4096;
+
+        enum class node_kind
+        {
+            frame,
+            composite,
+            code,
+            other,
+        };
+
+        // What write_json needs to know about a data type. The casts and demangling
+        // only depend on the dynamic type, so they are done once per type.
+        struct type_info_cache
+        {
+            std::type_info const* type;
+            node_kind kind;
+            std::string prefix;
+        };
+
+        auto describe(error_interface const& data) -> type_info_cache const&
+        {
+            // A tree usually has few distinct types, so a linear search over
+            // pointers beats hashing type names
+            thread_local std::vector<type_info_cache> types;
+
+            auto& type = typeid(data);
+            for (auto& cached : types)
+            {
+                if (cached.type == &type)
+                    return cached;
+            }
+
+            auto kind = node_kind::other;
+            if (dynamic_cast<error_frame_data const*>(&data))
+                kind = node_kind::frame;
+            else if (dynamic_cast<composite_message_interface const*>(&data))
+                kind = node_kind::composite;
+            else if (dynamic_cast<error_code_data const*>(&data))
+                kind = node_kind::code;
+
+            std::string prefix = "{\"type\":";
+            write_json_string(prefix, detail::demangle(type.name()));
+
+            types.push_back({&type, kind, std::move(prefix)});
+            return types.back();
+        }
+
+        // An error whose children are being written
+        struct open_error
+        {
+            error err;
+            error single;
+            error_span multiple;
+            std::size_t size;
+            std::size_t next;
+        };
+
+        // Text of a composite error's own message, without its children's messages
+        auto own_message(composite_message_interface const& composite) -> std::string
+        {
+            auto text = composite.message_layout().prefix;
+            while (!text.empty() && (text.back() == ' ' || text.back() == '\n'))
+                text.pop_back();
+
+            return text;
+        }
+
+        struct json_writer
+        {
+            json_writer(std::string& out, std::ostream* os, traversal_options const& options) :
+                out(out), os(os), options(options)
+            {}
+
+            std::string& out;
+            std::ostream* os;
+            traversal_options const& options;
+
+            std::vector<open_error> stack;
+            std::unique_ptr<std::unordered_set<error_interface const*>> seen;
+            std::size_t nodes = 0;
+
+            auto flush(bool force) -> void
+            {
+                if (os && (force || out.size() >= flush_threshold))
+                {
+                    os->write(out.data(), static_cast<std::streamsize>(out.size()));
+                    out.clear();
+                }
+            }
+
+            // Writes everything but the children and pushes err
+            // if it has children to write
+            auto open(error err, std::size_t depth) -> void
+            {
+                nodes++;
+
+                auto data = err.operator->();
+                auto& info = describe(*data);
+
+                out += info.prefix;
+
+                switch (info.kind)
+                {
+                case node_kind::frame:
+                    out += ",\"message\":";
+                    write_json_string(out, dynamic_cast<error_frame_data const*>(data)->context());
+                    break;
+
+                case node_kind::composite:
+                    out += ",\"message\":";
+                    write_json_string(out, own_message(*dynamic_cast<composite_message_interface const*>(data)));
+                    break;
+
+                case node_kind::code:
+                {
+                    auto code = dynamic_cast<error_code_data const*>(data);
+
+                    out += ",\"message\":";
+                    write_json_string(out, err.message());
+                    out += ",\"code\":{\"category\":";
+                    write_json_string(out, code->code().category().name());
+                    out += ",\"value\":";
+                    out += std::to_string(code->value());
+                    out += '}';
+                    break;
+                }
+
+                case node_kind::other:
+                    out += ",\"message\":";
+                    write_json_string(out, err.message());
+                    break;
+                }
+
+                // Like walk, errors seen past cycle_check_depth aren't expanded again
+                auto repeated = false;
+                if (depth > options.cycle_check_depth)
+                {
+                    if (!seen)
+                        seen = std::make_unique<std::unordered_set<error_interface const*>>();
+
+                    repeated = !seen->insert(data).second;
+                }
+
+                open_error entry{std::move(err), {}, {}, 0, 0};
+                if (!repeated && depth < options.max_depth && nodes < options.max_nodes)
+                {
+                    entry.single = entry.err.unwrap();
+                    if (entry.single)
+                    {
+                        entry.size = 1;
+                    }
+                    else
+                    {
+                        entry.multiple = entry.err.unwrap_span();
+                        entry.size = entry.multiple.size();
+                    }
+                }
+
+                if (entry.size == 0)
+                {
+                    out += '}';
+                    return;
+                }
+
+                out += ",\"children\":[";
+                stack.push_back(std::move(entry));
+            }
+
+            auto write(error const& err) -> void
+            {
+                if (!err)
+                {
+                    out += "null";
+                    flush(true);
+                    return;
+                }
+
+                open(err, 0);
+                while (!stack.empty())
+                {
+                    auto& top = stack.back();
+                    if (top.next == top.size)
+                    {
+                        out += "]}";
+                        stack.pop_back();
+                        continue;
+                    }
+
+                    if (top.next != 0)
+                        out += ',';
+
+                    // Copied, as opening the child may move the stack
+                    auto child = top.single ? top.single : top.multiple[top.next];
+                    top.next++;
+
+                    if (child)
+                        open(std::move(child), stack.size());
+                    else
+                        out += "null";
+
+                    flush(false);
+                }
+
+                flush(true);
+            }
+        };
+    }
+
+    auto write_json_string(std::string& out, std::string_view str) -> void
+    {
+        static constexpr char hex[] = "0123456789abcdef";
+
+        out += '"';
+
+        // Copies runs of characters that need no escaping at once
+        std::size_t run = 0;
+        for (std::size_t i = 0; i < str.size(); i++)
+        {
+            auto c = static_cast<unsigned char>(str[i]);
+            if (c >= 0x20 && c != '"' && c != '\\')
+                continue;
+
+            out.append(str.data() + run, i - run);
+            run = i + 1;
+
+            switch (c)
+            {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                out += "\\u00";
+                out += hex[c >> 4];
+                out += hex[c & 0xF];
+            }
+        }
+
+        out.append(str.data() + run, str.size() - run);
+        out += '"';
+    }
+
+    auto write_json(error const& err, std::string& out, traversal_options const& options) -> void
+    {
+        json_writer(out, nullptr, options).write(err);
+    }
+
+    auto write_json(error const& err, std::ostream& os, traversal_options const& options) -> void
+    {
+        std::string buffer;
+        buffer.reserve(flush_threshold * 2);
+
+        json_writer(buffer, &os, options).write(err);
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <go/error.hpp>
+#include <go/wrap.hpp>
+
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace go
+{
+    /*! \addtogroup serialization
+     * @{
+     */
+
+    /// Appends str to out as a quoted and escaped JSON string.
+    auto write_json_string(std::string& out, std::string_view str) -> void;
+
+    /// Appends err's tree to out as a JSON object.
+    /*!
+     * Every error is written as an object with its demangled data type under `type`,
+     * its message under `message`, the category and value of `go::error_code` errors
+     * under `code`, and the errors it wraps under `children`, if there are any:
+     *
+     * ```
+     * {"type":"go::error_frame_data","message":"loading config","children":[
+     *     {"type":"go::error_code_data","message":"No such file or directory (error code: 2)",
+     *      "code":{"category":"generic","value":2}}]}
+     * ```
+     *
+     * Errors that implement `go::composite_message_interface` only write their own
+     * part of the message, so that the messages of their children aren't repeated
+     * all the way up the tree: frames of `go::wrap_error` write their context, and
+     * other composite errors the prefix of their `go::message_layout`, without trailing
+     * whitespace, like the count of `go::error_multi`. Other errors write their full
+     * message.
+     *
+     * The tree is walked once with a heap allocated stack, so deep trees don't
+     * exhaust the call stack. Errors beyond options limits are written without
+     * their children. Like `go::is_error`, past options.cycle_check_depth errors
+     * that were already written are written again without their children, so
+     * unwrap cycles end. An empty error is written as `null`.
+     */
+    auto write_json(error const& err, std::string& out, traversal_options const& options = {}) -> void;
+
+    /// Writes err's tree into os as a JSON object. Refer to `go::write_json`.
+    /*!
+     * The output is streamed through a small buffer, so the whole document
+     * is never kept in memory.
+     */
+    auto write_json(error const& err, std::ostream& os, traversal_options const& options = {}) -> void;
+
+    /*! @} */
+}
@@ -0,0 +1,155 @@
+#include <go/json.hpp>
+#include <go/error_chain.hpp>
+#include <go/error_code.hpp>
+#include <go/error_fields.hpp>
+#include <go/errorf.hpp>
+#include <go/multi_error.hpp>
+
+#include <boost/ut.hpp>
+using namespace boost::ut;
+
+#include <sstream>
+
+// Error whose wrapped error can be made to point back at itself
+struct error_cycle_data : public go::error_interface
+{
+	go::error next;
+
+	std::string message() const override { return "cycle"; }
+	go::error unwrap() const override { return next; }
+};
+
+using error_cycle = go::error_of<error_cycle_data>;
+
+auto count_of(std::string const& out, std::string const& text) -> std::size_t
+{
+	std::size_t count = 0;
+	for (auto pos = out.find(text); pos != std::string::npos; pos = out.find(text, pos + 1))
+		count++;
+
+	return count;
+}
+
+int main()
+{
+	"write_json_string"_test = [] {
+		std::string out;
+		go::write_json_string(out, "a \"quoted\"\\path\n\x01");
+
+		expect(out == R"("a \"quoted\"\\path\n\u0001")") << "got" << out;
+	};
+
+	"write_json"_test = [] {
+		should("leaf errors write type and message") = [] {
+			std::string out;
+			go::write_json(go::errorf("oops"), out);
+
+			expect(out == R"({"type":"go::error_string_data","message":"oops"})") << "got" << out;
+		};
+
+		should("error codes write category and value") = [] {
+			auto ec = std::make_error_code(std::errc::invalid_argument);
+			std::string out;
+			go::write_json(go::make_error<go::error_code>(ec), out);
+
+			auto want = R"(,"code":{"category":"generic","value":)" + std::to_string(ec.value()) + "}}";
+			expect(out.find(want) != std::string::npos) << "got" << out;
+		};
+
+		should("frames and lists don't repeat child messages") = [] {
+			auto err = go::wrap_error(go::append_error(go::errorf("a"), go::errorf("b")), "validating");
+
+			std::string out;
+			go::write_json(err, out);
+
+			expect(out ==
+				R"({"type":"go::error_frame_data","message":"validating","children":[)"
+				R"({"type":"go::error_multi_data","message":"2 errors occurred:","children":[)"
+				R"({"type":"go::error_string_data","message":"a"},)"
+				R"({"type":"go::error_string_data","message":"b"}]}]})") << "got" << out;
+		};
+
+		should("every error writes a message") = [] {
+			auto err = go::join_errors(go::with_fields(go::errorf("a"), go::field("key", 1)), go::errorf("b"));
+
+			std::string out;
+			go::write_json(err, out);
+
+			// Demangled template arguments differ between compilers
+			std::size_t types = 0;
+			std::size_t messages = 0;
+			for (auto pos = out.find("\"type\":"); pos != std::string::npos; pos = out.find("\"type\":", pos + 1))
+				types++;
+			for (auto pos = out.find("\"message\":"); pos != std::string::npos; pos = out.find("\"message\":", pos + 1))
+				messages++;
+
+			expect(types == 4_ul) << "got" << out;
+			expect(messages == 4_ul) << "got" << out;
+			expect(out.find(R"("message":"","children":[{"type":"go::error_string_data","message":"a"}]})") != std::string::npos) << "got" << out;
+		};
+
+		should("empty error is null") = [] {
+			std::string out;
+			go::write_json({}, out);
+			expect(out == "null");
+		};
+
+		should("deep chains don't recurse") = [] {
+			go::error err = go::errorf("root");
+			for (int i = 0; i < 100000; i++)
+				err = go::wrap_error(std::move(err), "frame");
+
+			std::string out;
+			go::write_json(err, out);
+
+			expect(out.size() > 100000u * 10u);
+			expect(out.substr(out.size() - 4) == "]}]}") << "got" << out.substr(out.size() - 8);
+		};
+
+		should("unwrap cycles end") = [] {
+			auto cycle = go::make_error<error_cycle>();
+			cycle->next = cycle;
+
+			std::string out;
+			go::write_json(cycle, out);
+			expect(count_of(out, R"("message":"cycle")") == 67_ul) << "got" << out.size() << "bytes";
+
+			go::traversal_options options;
+			options.cycle_check_depth = 1;
+
+			out.clear();
+			go::write_json(cycle, out, options);
+			expect(count_of(out, R"("message":"cycle")") == 4_ul) << "got" << out;
+			expect(out.substr(out.size() - 14) == R"("cycle"}]}]}]})") << "got" << out;
+
+			cycle->next = {};
+		};
+
+		should("limits cut children off") = [] {
+			auto err = go::wrap_error(go::wrap_error(go::errorf("root"), "a"), "b");
+
+			go::traversal_options options;
+			options.max_depth = 1;
+
+			std::string out;
+			go::write_json(err, out, options);
+			expect(out.find("root") == std::string::npos) << "got" << out;
+			expect(out.find("\"a\"") != std::string::npos) << "got" << out;
+		};
+
+		should("streams match the buffer output") = [] {
+			go::error err;
+			for (int i = 0; i < 1000; i++)
+				err = go::append_error(std::move(err), go::errorf("child ", i));
+
+			std::string out;
+			go::write_json(err, out);
+
+			std::ostringstream os;
+			go::write_json(err, os);
+			expect(os.str() == out);
+		};
+	};
+
+	return 0;
+}
@@ -0,0 +1,271 @@
+#include <go/live_errors.hpp>
+#include <go/detail/demangle.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace go
+{
+#if defined(GOERROR_ENABLE_LIVE_TRACKING)
+    namespace
+    {
+        constexpr std::size_t shard_count = 16;
+
+        // Each counter gets its own cache line, so that threads don't share them
+        struct alignas(64) totals_shard
+        {
+            std::atomic<std::int64_t> count{0};
+            std::atomic<std::int64_t> bytes{0};
+        };
+
+        struct registry
+        {
+            std::atomic<int> mode{static_cast<int>(live_tracking_mode::totals)};
+            std::atomic<std::size_t> nextShard{0};
+            totals_shard shards[shard_count];
+
+            // Errors created in full mode
+            std::mutex mutex;
+            detail::live_hook* head = nullptr;
+
+            static auto get() -> registry&
+            {
+                // Never destroyed, since errors may outlive static destruction
+                static registry* instance = new registry;
+                return *instance;
+            }
+        };
+
+        // Errors may be released on a different thread than the one that created them,
+        // so the shards are only summed up as a whole
+        auto local_shard(registry& reg) noexcept -> totals_shard&
+        {
+            thread_local std::size_t index = reg.nextShard.fetch_add(1, std::memory_order_relaxed) % shard_count;
+            return reg.shards[index];
+        }
+
+        auto add(registry& reg, std::int64_t count, std::int64_t bytes) noexcept -> void
+        {
+            auto& shard = local_shard(reg);
+            shard.count.fetch_add(count, std::memory_order_relaxed);
+            shard.bytes.fetch_add(bytes, std::memory_order_relaxed);
+        }
+
+        auto type_name_of(std::type_info const* type) -> std::string
+        {
+            return type ? detail::demangle(type->name()) : std::string();
+        }
+    }
+
+    namespace detail
+    {
+        live_hook::~live_hook()
+        {
+            if (mode == static_cast<int>(live_tracking_mode::off))
+                return;
+
+            auto& reg = registry::get();
+            add(reg, -1, -static_cast<std::int64_t>(bytes));
+
+            if (mode == static_cast<int>(live_tracking_mode::full))
+            {
+                std::lock_guard<std::mutex> lock(reg.mutex);
+
+                if (prev)
+                    prev->next = next;
+                else
+                    reg.head = next;
+
+                if (next)
+                    next->prev = prev;
+            }
+        }
+
+        auto live_track(live_hook& hook, std::weak_ptr<error_interface> self,
+            std::type_info const& type, std::size_t bytes) -> void
+        {
+            auto& reg = registry::get();
+
+            auto mode = reg.mode.load(std::memory_order_relaxed);
+            if (mode == static_cast<int>(live_tracking_mode::off))
+                return;
+
+            hook.mode = mode;
+            hook.type = &type;
+            hook.bytes = bytes;
+            add(reg, 1, static_cast<std::int64_t>(bytes));
+
+            if (mode == static_cast<int>(live_tracking_mode::full))
+            {
+                hook.self = std::move(self);
+
+                std::lock_guard<std::mutex> lock(reg.mutex);
+                hook.next = reg.head;
+                if (reg.head)
+                    reg.head->prev = &hook;
+
+                reg.head = &hook;
+            }
+        }
+    }
+
+    auto set_live_tracking_mode(live_tracking_mode mode) noexcept -> void
+    {
+        registry::get().mode.store(static_cast<int>(mode), std::memory_order_relaxed);
+    }
+
+    auto get_live_tracking_mode() noexcept -> live_tracking_mode
+    {
+        return static_cast<live_tracking_mode>(registry::get().mode.load(std::memory_order_relaxed));
+    }
+
+    auto live_error_totals() noexcept -> live_totals
+    {
+        auto& reg = registry::get();
+
+        std::int64_t count = 0;
+        std::int64_t bytes = 0;
+        for (auto& shard : reg.shards)
+        {
+            count += shard.count.load(std::memory_order_relaxed);
+            bytes += shard.bytes.load(std::memory_order_relaxed);
+        }
+
+        // Shards are read one by one, so a release counted before its creation may be seen
+        return {static_cast<std::uint64_t>(std::max<std::int64_t>(count, 0)),
+            static_cast<std::uint64_t>(std::max<std::int64_t>(bytes, 0))};
+    }
+
+    auto dump_live_errors(std::size_t max_trees) -> std::vector<live_error_tree>
+    {
+        struct tracked
+        {
+            error err;
+            std::type_info const* type;
+            std::size_t bytes;
+            bool referenced;
+        };
+
+        std::vector<tracked> nodes;
+        std::unordered_map<error_interface const*, std::size_t> index;
+
+        // Strong references taken here may end up being the last ones, so the
+        // lock must not be held when nodes is destroyed
+        {
+            auto& reg = registry::get();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+
+            for (auto hook = reg.head; hook; hook = hook->next)
+            {
+                // Errors that are being destroyed can't be locked anymore
+                auto self = hook->self.lock();
+                if (self)
+                    nodes.push_back({error(std::move(self)), hook->type, hook->bytes, false});
+            }
+        }
+
+        for (std::size_t i = 0; i < nodes.size(); i++)
+            index.emplace(nodes[i].err.data().get(), i);
+
+        auto forEachChild = [](error const& err, auto&& f)
+        {
+            if (auto child = err.unwrap())
+            {
+                f(child);
+                return;
+            }
+
+            for (auto& child : err.unwrap_span())
+                f(child);
+        };
+
+        // Marks tracked errors reachable from other errors, looking through
+        // untracked ones like wrap_error frames
+        std::unordered_set<error_interface const*> seenUntracked;
+        std::vector<error> pending;
+        for (auto& node : nodes)
+        {
+            pending.push_back(node.err);
+            while (!pending.empty())
+            {
+                auto current = std::move(pending.back());
+                pending.pop_back();
+
+                forEachChild(current, [&](error const& child)
+                {
+                    auto found = index.find(child.data().get());
+                    if (found != index.end())
+                        nodes[found->second].referenced = true;
+                    else if (seenUntracked.insert(child.data().get()).second)
+                        pending.push_back(child);
+                });
+            }
+        }
+
+        std::vector<live_error_tree> trees;
+        for (auto& node : nodes)
+        {
+            if (node.referenced)
+                continue;
+
+            live_error_tree tree;
+            tree.root = node.err;
+            tree.type_name = type_name_of(node.type);
+
+            std::unordered_set<error_interface const*> visited{node.err.data().get()};
+            pending.push_back(node.err);
+            while (!pending.empty())
+            {
+                auto current = std::move(pending.back());
+                pending.pop_back();
+
+                auto found = index.find(current.data().get());
+                if (found != index.end())
+                {
+                    tree.nodes++;
+                    tree.bytes += nodes[found->second].bytes;
+                }
+
+                forEachChild(current, [&](error const& child)
+                {
+                    if (visited.insert(child.data().get()).second)
+                        pending.push_back(child);
+                });
+            }
+
+            trees.push_back(std::move(tree));
+        }
+
+        std::sort(trees.begin(), trees.end(), [](auto& lhs, auto& rhs)
+        {
+            return lhs.bytes > rhs.bytes;
+        });
+
+        if (trees.size() > max_trees)
+            trees.erase(trees.begin() + max_trees, trees.end());
+
+        return trees;
+    }
+#else
+    auto set_live_tracking_mode(live_tracking_mode) noexcept -> void
+    {}
+
+    auto get_live_tracking_mode() noexcept -> live_tracking_mode
+    {
+        return live_tracking_mode::off;
+    }
+
+    auto live_error_totals() noexcept -> live_totals
+    {
+        return {};
+    }
+
+    auto dump_live_errors(std::size_t) -> std::vector<live_error_tree>
+    {
+        return {};
+    }
+#endif
+}
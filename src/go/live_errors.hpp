@@ -0,0 +1,102 @@
+#pragma once
+
+#include <go/error.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace go
+{
+    /*! \addtogroup instrumentation
+     * @{
+     */
+
+    /// True when the library was compiled with `GOERROR_ENABLE_LIVE_TRACKING`.
+    /*!
+     * Without it errors carry no bookkeeping, `go::live_error_totals` always
+     * returns zeros and `go::dump_live_errors` returns nothing.
+     */
+#if defined(GOERROR_ENABLE_LIVE_TRACKING)
+    inline constexpr bool live_tracking_enabled = true;
+#else
+    inline constexpr bool live_tracking_enabled = false;
+#endif
+
+    /// How much bookkeeping is done for errors created from now on.
+    enum class live_tracking_mode
+    {
+        /// Errors aren't tracked.
+        off,
+
+        /// Only the number of live errors and their size is counted, in
+        /// sharded atomic counters. This is the default.
+        totals,
+
+        /// Additionally links every error into a list under a mutex,
+        /// so that `go::dump_live_errors` can find them.
+        full,
+    };
+
+    /// Number and approximate size of errors that are currently alive.
+    struct live_totals
+    {
+        /// Number of live errors.
+        std::uint64_t count = 0;
+
+        /// Approximate size of live errors in bytes.
+        std::uint64_t bytes = 0;
+    };
+
+    /// A tree of live errors that isn't referenced by any other tracked error.
+    struct live_error_tree
+    {
+        /// The root of the tree. Holding it keeps the tree alive.
+        error root;
+
+        /// Demangled name of the root's error data type.
+        std::string type_name;
+
+        /// Number of tracked errors reachable from the root, including the root.
+        std::size_t nodes = 0;
+
+        /// Approximate size of the tracked errors reachable from the root.
+        std::size_t bytes = 0;
+    };
+
+    /// Changes how errors created from now on are tracked.
+    /*!
+     * Each error remembers the mode it was created with, so switching modes
+     * at runtime is safe. Errors created before switching to
+     * `live_tracking_mode::full` don't show up in dumps.
+     */
+    auto set_live_tracking_mode(live_tracking_mode mode) noexcept -> void;
+
+    /// Returns the mode used for newly created errors.
+    auto get_live_tracking_mode() noexcept -> live_tracking_mode;
+
+    /// Returns the number and size of errors that are alive.
+    /*!
+     * Errors are tracked when created by `go::make_error`, `go::make_traced_error`
+     * and `go::make_error_at`. Frames of `go::wrap_error` share allocations with
+     * each other and aren't tracked, but the errors they wrap are.
+     *
+     * The size is the size of the error data plus the reference counts. Memory
+     * owned by the error data, such as message strings, isn't included.
+     */
+    auto live_error_totals() noexcept -> live_totals;
+
+    /// Lists up to max_trees of the largest trees of live errors, largest first.
+    /*!
+     * Only errors created in `live_tracking_mode::full` are considered. An error
+     * is a root if no other tracked error unwraps into it, directly or through
+     * untracked errors. Trees are compared by their size in bytes.
+     *
+     * The returned trees hold their roots, so the dump should be discarded
+     * once inspected. Intended for diagnostics, as it walks all tracked errors.
+     */
+    auto dump_live_errors(std::size_t max_trees = 10) -> std::vector<live_error_tree>;
+
+    /*! @} */
+}
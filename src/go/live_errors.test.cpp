@@ -0,0 +1,123 @@
+#include <go/go_error.hpp>
+#include <go/live_errors.hpp>
+
+#include <boost/ut.hpp>
+using namespace boost::ut;
+
+#include <thread>
+
+struct error_leaf_data : public go::error_interface
+{
+	std::string message() const override { return "leaf"; }
+};
+
+using error_leaf = go::error_of<error_leaf_data>;
+
+struct error_group_data : public go::error_interface
+{
+	error_group_data(std::vector<go::error> errs) :
+		errs_(std::move(errs))
+	{}
+
+	std::string message() const override { return "group"; }
+
+	std::vector<go::error> const& unwrap_multiple() const override { return errs_; }
+
+private:
+	std::vector<go::error> errs_;
+};
+
+using error_group = go::error_of<error_group_data>;
+
+int main()
+{
+	"live_errors"_test = [] {
+		expect(go::live_tracking_enabled == true) << "live errors test must be built with GOERROR_ENABLE_LIVE_TRACKING";
+
+		should("totals follow error lifetimes") = [] {
+			go::set_live_tracking_mode(go::live_tracking_mode::totals);
+			auto before = go::live_error_totals();
+
+			{
+				std::vector<go::error> errs;
+				for (int i = 0; i < 10; i++)
+					errs.push_back(go::make_error<error_leaf>());
+
+				auto during = go::live_error_totals();
+				expect(during.count - before.count == 10_ul);
+				expect(during.bytes - before.bytes >= 10 * sizeof(error_leaf_data));
+			}
+
+			auto after = go::live_error_totals();
+			expect(after.count == before.count);
+			expect(after.bytes == before.bytes);
+		};
+
+		should("errors released on other threads are subtracted") = [] {
+			go::set_live_tracking_mode(go::live_tracking_mode::totals);
+			auto before = go::live_error_totals();
+
+			go::error err = go::make_error<error_leaf>();
+			std::thread([err = std::move(err)]() mutable { err = {}; }).join();
+
+			expect(go::live_error_totals().count == before.count);
+		};
+
+		should("off mode doesn't count") = [] {
+			go::set_live_tracking_mode(go::live_tracking_mode::off);
+			auto before = go::live_error_totals();
+
+			auto err = go::make_error<error_leaf>();
+			expect(go::live_error_totals().count == before.count);
+
+			go::set_live_tracking_mode(go::live_tracking_mode::totals);
+		};
+
+		should("dump lists the largest trees first") = [] {
+			go::set_live_tracking_mode(go::live_tracking_mode::full);
+
+			auto single = go::make_error<error_leaf>();
+			auto shared = go::make_error<error_leaf>();
+
+			go::error big = go::make_error<error_group>(std::vector<go::error>{
+				go::make_error<error_leaf>(),
+				go::wrap_error(shared, "context"),
+				go::make_error<error_group>(std::vector<go::error>{go::make_error<error_leaf>(), shared}),
+			});
+
+			auto trees = go::dump_live_errors();
+			expect(trees.size() == 2_ul);
+
+			expect(trees[0].root == big);
+			expect(trees[0].type_name.find("error_group_data") != std::string::npos);
+			expect(trees[0].nodes == 5_ul) << "got" << trees[0].nodes;
+
+			expect(trees[1].root == single);
+			expect(trees[1].nodes == 1_ul);
+			expect(trees[0].bytes > trees[1].bytes);
+
+			expect(go::dump_live_errors(1).size() == 1_ul);
+
+			trees.clear();
+			big = {};
+			expect(go::dump_live_errors().size() == 2_ul) << "shared leaf is a root now";
+
+			go::set_live_tracking_mode(go::live_tracking_mode::totals);
+		};
+
+		should("errors created before full mode aren't dumped") = [] {
+			auto old = go::make_error<error_leaf>();
+
+			go::set_live_tracking_mode(go::live_tracking_mode::full);
+			auto fresh = go::make_error<error_leaf>();
+
+			auto trees = go::dump_live_errors();
+			expect(trees.size() == 1_ul);
+			expect(trees[0].root == fresh);
+
+			go::set_live_tracking_mode(go::live_tracking_mode::totals);
+		};
+	};
+
+	return 0;
+}
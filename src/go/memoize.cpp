@@ -0,0 +1,113 @@
+#include <go/memoize.hpp>
+#include <go/render.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace go
+{
+    auto memoized_message::render_and_cache() const -> std::string_view
+    {
+        auto rendered = std::make_unique<std::string const>(render_message());
+
+        // The first thread to finish rendering publishes its string, others discard theirs
+        std::string const* expected = nullptr;
+        if (cached_.compare_exchange_strong(expected, rendered.get(), std::memory_order_acq_rel, std::memory_order_acquire))
+            return *rendered.release();
+
+        return *expected;
+    }
+
+    namespace
+    {
+        // Appends the message of err unless it is laid out around the messages of the
+        // errors it wraps and isn't cached yet, in which case its layout is returned
+        auto append_leaf(std::string& out, error const& err) -> composite_message_interface const*
+        {
+            auto data = err.operator->();
+            auto memoized = dynamic_cast<memoized_message const*>(data);
+            if (memoized && memoized->has_cached_message())
+            {
+                out += memoized->message_view();
+                return nullptr;
+            }
+
+            if (auto composite = dynamic_cast<composite_message_interface const*>(data))
+                return composite;
+
+            out += err.message();
+            return nullptr;
+        }
+    }
+
+    auto append_message(std::string& out, error const& err) -> void
+    {
+        auto composite = append_leaf(out, err);
+        if (!composite)
+            return;
+
+        // The errors of composite messages are rendered into out without memoizing
+        // them, so that only the error whose message was asked for keeps a copy
+        struct open_error
+        {
+            message_layout layout;
+            error single;
+            error_span children;
+            std::size_t next;
+        };
+
+        std::vector<open_error> stack;
+        auto open = [&](error const& e, composite_message_interface const* c)
+        {
+            open_error entry{c->message_layout(), e.unwrap(), {}, 0};
+            if (!entry.single)
+                entry.children = e.unwrap_span();
+
+            out += entry.layout.prefix;
+            stack.push_back(std::move(entry));
+        };
+
+        open(err, composite);
+        while (!stack.empty())
+        {
+            auto& top = stack.back();
+            auto size = top.single ? 1 : top.children.size();
+            if (top.next == size)
+            {
+                out += top.layout.suffix;
+                stack.pop_back();
+
+                if (!stack.empty())
+                    out += stack.back().layout.after_each;
+
+                continue;
+            }
+
+            if (top.next != 0)
+                out += top.layout.between;
+
+            out += top.layout.before_each;
+
+            // Only used until open moves the stack
+            auto& child = top.single ? top.single : top.children[top.next];
+            top.next++;
+
+            if (auto childComposite = append_leaf(out, child))
+                open(child, childComposite);
+            else
+                out += top.layout.after_each;
+        }
+    }
+
+    namespace detail
+    {
+        auto message_view(error_interface const* data, std::string& buffer) -> std::string_view
+        {
+            if (auto memoized = dynamic_cast<memoized_message const*>(data))
+                return memoized->message_view();
+
+            buffer = data ? data->message() : "<nil>";
+            return buffer;
+        }
+    }
+}
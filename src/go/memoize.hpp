@@ -0,0 +1,104 @@
+#pragma once
+
+#include <go/error.hpp>
+
+#include <atomic>
+#include <string>
+#include <string_view>
+
+namespace go
+{
+    /*! \addtogroup core
+     * @{
+     */
+
+    /// Mixin for error data that renders its message once and keeps it.
+    /*!
+     * Error data that derives from it implements `render_message` instead of
+     * computing its message on every call, and returns `message_view()` from
+     * `message`. The first call renders and caches the message, later calls
+     * return the cached string. Concurrent first calls may render the message more
+     * than once, but all of them return the same cached string.
+     *
+     * ```
+     * struct error_query_data : public go::error_interface, public go::memoized_message
+     * {
+     *     auto message() const -> std::string override
+     *     {
+     *         return std::string(message_view());
+     *     }
+     *
+     * protected:
+     *     auto render_message() const -> std::string override { ... }
+     * };
+     * ```
+     *
+     * Only suitable for error data whose message never changes once it is created,
+     * or that resets the cache with `reset_message` while it is the only owner of itself.
+     * Use `go::append_message` or `go::error_of::message_view` to read the message of
+     * an error without copying it if it is memoized.
+     */
+    class memoized_message
+    {
+    public:
+        /// Returns the message, rendering it on the first call. Stays valid as long
+        /// as the error data is alive and the cache isn't reset.
+        auto message_view() const -> std::string_view
+        {
+            if (auto cached = cached_.load(std::memory_order_acquire))
+                return *cached;
+
+            return render_and_cache();
+        }
+
+        /// True if the message was already rendered and cached.
+        auto has_cached_message() const noexcept -> bool
+        {
+            return cached_.load(std::memory_order_acquire) != nullptr;
+        }
+
+        virtual ~memoized_message() noexcept
+        {
+            delete cached_.load(std::memory_order_relaxed);
+        }
+
+    protected:
+        memoized_message() = default;
+
+        /// The cache isn't copied, copies render their message again.
+        memoized_message(memoized_message const&) noexcept {}
+
+        /// Moves the cache, expects no concurrent readers of other.
+        memoized_message(memoized_message&& other) noexcept :
+            cached_(other.cached_.exchange(nullptr, std::memory_order_relaxed))
+        {}
+
+        memoized_message& operator=(memoized_message const&) = delete;
+
+        /// Returns the message to be cached.
+        virtual auto render_message() const -> std::string = 0;
+
+        /// Drops the cached message. Must only be called while no other thread may
+        /// read the message.
+        auto reset_message() noexcept -> void
+        {
+            delete cached_.exchange(nullptr, std::memory_order_relaxed);
+        }
+
+    private:
+        auto render_and_cache() const -> std::string_view;
+
+        mutable std::atomic<std::string const*> cached_{nullptr};
+    };
+
+    /// Appends the message of err to out. Memoized messages are appended from their cache.
+    /*!
+     * Errors that implement `go::composite_message_interface` and aren't cached yet are
+     * rendered piece by piece into out, without memoizing them or the errors they wrap.
+     * Memoized wrappers render their message with it, so that a chain rendered once
+     * only keeps the message of its outermost error.
+     */
+    auto append_message(std::string& out, error const& err) -> void;
+
+    /*! @} */
+}
@@ -0,0 +1,160 @@
+#include <go/memoize.hpp>
+#include <go/error_chain.hpp>
+#include <go/error_fields.hpp>
+#include <go/errorf.hpp>
+#include <go/multi_error.hpp>
+#include <go/wrap.hpp>
+
+#include <boost/ut.hpp>
+using namespace boost::ut;
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+std::atomic<int> renders{0};
+
+struct error_counted_data : public go::error_interface, public go::memoized_message
+{
+	std::string message() const override
+	{
+		return std::string(message_view());
+	}
+
+protected:
+	std::string render_message() const override
+	{
+		renders++;
+		return "counted";
+	}
+};
+
+using error_counted = go::error_of<error_counted_data>;
+
+int main()
+{
+	"memoized_message"_test = [] {
+		should("render the message once") = [] {
+			renders = 0;
+			auto err = go::make_error<error_counted>();
+
+			expect(err.message() == "counted");
+			expect(err.message() == "counted");
+			expect(err->message_view() == "counted");
+			expect(renders.load() == 1_i);
+			expect(err->message_view().data() == err->message_view().data());
+		};
+
+		should("concurrent first calls return the same message") = [] {
+			renders = 0;
+			auto err = go::make_error<error_counted>();
+
+			std::vector<char const*> seen(8);
+			std::vector<std::thread> threads;
+			for (std::size_t i = 0; i < seen.size(); i++)
+				threads.emplace_back([&, i] { seen[i] = err->message_view().data(); });
+
+			for (auto& t : threads)
+				t.join();
+
+			for (auto data : seen)
+				expect(data == seen.front());
+
+			expect(renders.load() >= 1_i);
+		};
+
+		should("append_message appends memoized and plain messages") = [] {
+			std::string out;
+			go::append_message(out, go::make_error<error_counted>());
+			out += ' ';
+			go::append_message(out, go::errorf("plain"));
+			out += ' ';
+			go::append_message(out, go::error());
+
+			expect(out == "counted plain <nil>") << "got" << out;
+		};
+	};
+
+	"predefined wrappers"_test = [] {
+		should("frames memoize their message") = [] {
+			renders = 0;
+			auto err = go::wrap_error(go::wrap_error(go::make_error<error_counted>(), "inner"), "outer");
+
+			expect(err.message() == "outer: inner: counted");
+			expect(err.message() == "outer: inner: counted");
+			expect(renders.load() == 1_i);
+
+			go::error_frame frame;
+			expect(go::as_error(err, frame));
+			expect(frame->message_view().data() == frame->message_view().data());
+		};
+
+		should("only the outermost rendered error keeps its message") = [] {
+			auto inner = go::wrap_error(go::append_error(go::errorf("a"), go::errorf("b")), "inner");
+			auto err = go::wrap_error(inner, "outer");
+
+			expect(err.message() == "outer: inner: 2 errors occurred:\n\t* a\n\t* b\n\n");
+
+			auto memoized = [](go::error const& e) { return dynamic_cast<go::memoized_message const*>(e.operator->()); };
+			expect(memoized(err)->has_cached_message());
+			expect(memoized(inner)->has_cached_message() == false);
+			expect(memoized(inner.unwrap())->has_cached_message() == false);
+
+			// Cached inner messages are reused as they are
+			expect(inner.message() == "inner: 2 errors occurred:\n\t* a\n\t* b\n\n");
+			expect(go::wrap_error(inner, "again").message() == "again: " + inner.message());
+		};
+
+		should("message_view views memoized messages in place") = [] {
+			auto err = go::wrap_error(go::errorf("root"), "context");
+
+			std::string buffer;
+			auto view = err.message_view(buffer);
+			expect(view == "context: root");
+			expect(buffer.empty());
+			expect(err.message_view(buffer).data() == view.data());
+
+			expect(go::errorf("plain").message_view(buffer) == "plain");
+			expect(buffer == "plain");
+			expect(go::error().message_view(buffer) == "<nil>");
+		};
+
+		should("frames keep their message when the chain grows") = [] {
+			auto err = go::wrap_error(go::errorf("root"), "first");
+			auto view = std::string_view();
+			{
+				go::error_frame frame;
+				go::as_error(err, frame);
+				view = frame->message_view();
+			}
+
+			for (int i = 0; i < 100; i++)
+				err = go::wrap_error(std::move(err), "again");
+
+			expect(view == "first: root");
+		};
+
+		should("lists render their message again after being extended") = [] {
+			auto err = go::append_error(go::errorf("a"));
+			expect(err.message() == "1 error occurred:\n\t* a\n\n");
+
+			err = go::append_error(std::move(err), go::errorf("b"));
+			expect(err.message() == "2 errors occurred:\n\t* a\n\t* b\n\n") << "got" << err.message();
+		};
+
+		should("joins and fields memoize their message") = [] {
+			renders = 0;
+			auto counted = go::make_error<error_counted>();
+			auto join = go::join_errors(counted, go::errorf("b"));
+			auto fields = go::with_fields(counted, go::field("key", 1));
+
+			expect(join.message() == "counted\nb");
+			expect(join.message() == "counted\nb");
+			expect(fields.message() == "counted");
+			expect(fields.message() == "counted");
+			expect(renders.load() == 1_i);
+		};
+	};
+
+	return 0;
+}
@@ -0,0 +1,194 @@
+#include <go/metrics.hpp>
+#include <go/error.hpp>
+#include <go/detail/demangle.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <typeinfo>
+
+namespace go
+{
+    namespace
+    {
+        // Types registered after this many share the last counter
+        constexpr std::size_t max_types = 512;
+
+        using counters = std::array<std::atomic<std::uint64_t>, max_types>;
+        using histogram_counters = std::array<std::atomic<std::uint64_t>, metrics_histogram::bucket_count>;
+
+        struct shard;
+
+        struct registry
+        {
+            std::mutex mutex;
+            std::vector<std::type_info const*> types;
+            std::vector<shard*> shards;
+
+            // Counters of exited threads
+            std::array<std::uint64_t, max_types> retiredCreated{};
+            metrics_histogram retiredDepth;
+            metrics_histogram retiredNodes;
+
+            static auto get() -> registry&
+            {
+                static registry instance;
+                return instance;
+            }
+        };
+
+        // Counters of a single thread. Only the owning thread writes them,
+        // snapshots read them concurrently with relaxed loads.
+        //
+        // Resets don't write the counters, which would race with the owner's
+        // increments and lose them. They record the values at the time of the
+        // reset instead, which snapshots subtract. The baselines are guarded
+        // by the registry's mutex.
+        struct shard
+        {
+            counters created{};
+            histogram_counters depth{};
+            histogram_counters nodes{};
+
+            std::array<std::uint64_t, max_types> createdBaseline{};
+            metrics_histogram depthBaseline;
+            metrics_histogram nodesBaseline;
+
+            auto created_since_reset(std::size_t i) const -> std::uint64_t
+            {
+                return created[i].load(std::memory_order_relaxed) - createdBaseline[i];
+            }
+
+            auto depth_since_reset(std::size_t i) const -> std::uint64_t
+            {
+                return depth[i].load(std::memory_order_relaxed) - depthBaseline.buckets[i];
+            }
+
+            auto nodes_since_reset(std::size_t i) const -> std::uint64_t
+            {
+                return nodes[i].load(std::memory_order_relaxed) - nodesBaseline.buckets[i];
+            }
+
+            shard()
+            {
+                auto& reg = registry::get();
+                std::lock_guard<std::mutex> lock(reg.mutex);
+                reg.shards.push_back(this);
+            }
+
+            ~shard()
+            {
+                auto& reg = registry::get();
+                std::lock_guard<std::mutex> lock(reg.mutex);
+
+                for (std::size_t i = 0; i < max_types; i++)
+                    reg.retiredCreated[i] += created_since_reset(i);
+
+                for (std::size_t i = 0; i < metrics_histogram::bucket_count; i++)
+                {
+                    reg.retiredDepth.buckets[i] += depth_since_reset(i);
+                    reg.retiredNodes.buckets[i] += nodes_since_reset(i);
+                }
+
+                reg.shards.erase(std::find(reg.shards.begin(), reg.shards.end(), this));
+            }
+        };
+
+        auto local_shard() -> shard&
+        {
+            thread_local shard instance;
+            return instance;
+        }
+
+        auto bump(std::atomic<std::uint64_t>& counter) noexcept -> void
+        {
+            // Single writer, so a separate load and store is enough
+            counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+    }
+
+    namespace detail
+    {
+        auto metrics_register_type(std::type_info const& type) -> std::size_t
+        {
+            auto& reg = registry::get();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+
+            auto found = std::find(reg.types.begin(), reg.types.end(), &type);
+            if (found != reg.types.end())
+                return static_cast<std::size_t>(found - reg.types.begin());
+
+            if (reg.types.size() == max_types)
+                return max_types - 1;
+
+            reg.types.push_back(&type);
+            return reg.types.size() - 1;
+        }
+
+        auto metrics_count_creation(std::size_t slot) noexcept -> void
+        {
+            bump(local_shard().created[slot]);
+        }
+
+        auto metrics_count_traversal(std::size_t depth, std::size_t nodes) noexcept -> void
+        {
+            auto& local = local_shard();
+            bump(local.depth[metrics_histogram::bucket_of(depth)]);
+            bump(local.nodes[metrics_histogram::bucket_of(nodes)]);
+        }
+    }
+
+    auto snapshot_metrics() -> metrics_snapshot
+    {
+        metrics_snapshot snapshot;
+
+        auto& reg = registry::get();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+
+        auto created = reg.retiredCreated;
+        snapshot.traversal_depth = reg.retiredDepth;
+        snapshot.traversal_nodes = reg.retiredNodes;
+
+        for (auto s : reg.shards)
+        {
+            for (std::size_t i = 0; i < reg.types.size(); i++)
+                created[i] += s->created_since_reset(i);
+
+            for (std::size_t i = 0; i < metrics_histogram::bucket_count; i++)
+            {
+                snapshot.traversal_depth.buckets[i] += s->depth_since_reset(i);
+                snapshot.traversal_nodes.buckets[i] += s->nodes_since_reset(i);
+            }
+        }
+
+        for (std::size_t i = 0; i < reg.types.size(); i++)
+        {
+            if (created[i] != 0)
+                snapshot.created.push_back({detail::demangle(reg.types[i]->name()), created[i]});
+        }
+
+        return snapshot;
+    }
+
+    auto reset_metrics() -> void
+    {
+        auto& reg = registry::get();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+
+        reg.retiredCreated = {};
+        reg.retiredDepth = {};
+        reg.retiredNodes = {};
+
+        for (auto s : reg.shards)
+        {
+            for (std::size_t i = 0; i < max_types; i++)
+                s->createdBaseline[i] = s->created[i].load(std::memory_order_relaxed);
+
+            for (std::size_t i = 0; i < metrics_histogram::bucket_count; i++)
+            {
+                s->depthBaseline.buckets[i] = s->depth[i].load(std::memory_order_relaxed);
+                s->nodesBaseline.buckets[i] = s->nodes[i].load(std::memory_order_relaxed);
+            }
+        }
+    }
+}
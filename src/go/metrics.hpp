@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace go
+{
+    /*! \addtogroup instrumentation Instrumentation
+     * @{
+     */
+
+    /// True when the library was compiled with `GOERROR_ENABLE_METRICS`.
+    /*!
+     * Without it the instrumentation hooks compile to nothing, and
+     * `go::snapshot_metrics` always returns an empty snapshot.
+     */
+#if defined(GOERROR_ENABLE_METRICS)
+    inline constexpr bool metrics_enabled = true;
+#else
+    inline constexpr bool metrics_enabled = false;
+#endif
+
+    /// Histogram with power of two buckets.
+    /*!
+     * Bucket 0 counts zeros, bucket i counts values in [2^(i-1), 2^i - 1].
+     * The last bucket also counts everything above its range.
+     */
+    struct metrics_histogram
+    {
+        /// Number of buckets.
+        static constexpr std::size_t bucket_count = 32;
+
+        /// Number of recorded values per bucket.
+        std::array<std::uint64_t, bucket_count> buckets{};
+
+        /// Returns the bucket index a value is recorded into.
+        static constexpr auto bucket_of(std::uint64_t value) noexcept -> std::size_t
+        {
+            std::size_t bucket = 0;
+            while (value != 0 && bucket < bucket_count - 1)
+            {
+                value >>= 1;
+                bucket++;
+            }
+
+            return bucket;
+        }
+
+        /// Returns the largest value recorded into a bucket.
+        static constexpr auto bucket_upper_bound(std::size_t bucket) noexcept -> std::uint64_t
+        {
+            return bucket == 0 ? 0 : (std::uint64_t(1) << bucket) - 1;
+        }
+
+        /// Returns the number of recorded values.
+        auto total() const noexcept -> std::uint64_t
+        {
+            std::uint64_t sum = 0;
+            for (auto count : buckets)
+                sum += count;
+
+            return sum;
+        }
+    };
+
+    /// Number of errors of a single error data type created so far.
+    struct metrics_type_count
+    {
+        /// Demangled name of the error data type.
+        std::string type_name;
+
+        /// Number of errors created.
+        std::uint64_t count = 0;
+    };
+
+    /// Aggregated state of the instrumentation counters.
+    struct metrics_snapshot
+    {
+        /// Creation counts per error data type, for types that were created at least once.
+        std::vector<metrics_type_count> created;
+
+        /// Maximum depth reached by each traversal of an error tree. The root has depth 0.
+        metrics_histogram traversal_depth;
+
+        /// Number of errors visited by each traversal of an error tree.
+        metrics_histogram traversal_nodes;
+    };
+
+    /// Collects counters from all threads into a snapshot.
+    /*!
+     * Counters are kept per thread, so recording them never contends. Taking a
+     * snapshot sums counters of all running threads and of the threads that have
+     * already exited.
+     *
+     * Errors are counted when created by `go::make_error`, `go::make_traced_error`,
+     * `go::make_error_at` and `go::wrap_error`. Traversals are counted for `go::is_error`,
+     * `go::as_error` and the other functions that walk error trees.
+     */
+    auto snapshot_metrics() -> metrics_snapshot;
+
+    /// Resets all counters to zero.
+    auto reset_metrics() -> void;
+
+    /*! @} */
+}
@@ -0,0 +1,157 @@
+#include <go/go_error.hpp>
+#include <go/metrics.hpp>
+
+#include <boost/ut.hpp>
+using namespace boost::ut;
+
+#include <atomic>
+#include <thread>
+
+struct error_counted_data : public go::error_interface
+{
+	std::string message() const override { return "counted"; }
+};
+
+using error_counted = go::error_of<error_counted_data>;
+
+struct error_other_data : public go::error_interface
+{
+	std::string message() const override { return "other"; }
+};
+
+using error_other = go::error_of<error_other_data>;
+
+auto created(go::metrics_snapshot const& snapshot, std::string const& typeName) -> std::uint64_t
+{
+	for (auto& entry : snapshot.created)
+	{
+		if (entry.type_name.find(typeName) != std::string::npos)
+			return entry.count;
+	}
+
+	return 0;
+}
+
+int main()
+{
+	"metrics"_test = [] {
+		expect(go::metrics_enabled == true) << "metrics test must be built with GOERROR_ENABLE_METRICS";
+
+		should("creations are counted per type") = [] {
+			go::reset_metrics();
+
+			for (int i = 0; i < 5; i++)
+				go::make_error<error_counted>();
+
+			go::make_error<error_other>();
+			go::make_traced_error<error_other>();
+
+			auto snapshot = go::snapshot_metrics();
+			expect(created(snapshot, "error_counted_data") == 5_ul);
+			expect(created(snapshot, "error_other_data") == 2_ul);
+		};
+
+		should("counts of other threads are aggregated, including exited ones") = [] {
+			go::reset_metrics();
+
+			std::vector<std::thread> threads;
+			for (int t = 0; t < 4; t++)
+			{
+				threads.emplace_back([] {
+					for (int i = 0; i < 100; i++)
+						go::make_error<error_counted>();
+				});
+			}
+
+			for (auto& thread : threads)
+				thread.join();
+
+			go::make_error<error_counted>();
+
+			auto snapshot = go::snapshot_metrics();
+			expect(created(snapshot, "error_counted_data") == 401_ul) << "got" << created(snapshot, "error_counted_data");
+		};
+
+		should("wrap_error frames are counted") = [] {
+			go::reset_metrics();
+
+			auto err = go::wrap_error(go::make_error<error_counted>(), "a");
+			err = go::wrap_error(std::move(err), "b");
+
+			auto snapshot = go::snapshot_metrics();
+			expect(created(snapshot, "error_frame_data") == 2_ul);
+		};
+
+		should("traversals record depth and visited errors") = [] {
+			auto target = go::make_error<error_other>();
+			auto err = go::wrap_error(go::make_error<error_counted>(), "a");
+			err = go::wrap_error(std::move(err), "b");
+			err = go::wrap_error(std::move(err), "c");
+
+			go::reset_metrics();
+
+			expect(go::is_error(err, target) == false);
+
+			auto snapshot = go::snapshot_metrics();
+			expect(snapshot.traversal_depth.total() == 1_ul);
+			expect(snapshot.traversal_nodes.total() == 1_ul);
+
+			// 4 errors deep is depth 3, which lands into the [2, 3] bucket
+			expect(snapshot.traversal_depth.buckets[go::metrics_histogram::bucket_of(3)] == 1_ul);
+			expect(snapshot.traversal_nodes.buckets[go::metrics_histogram::bucket_of(4)] == 1_ul);
+		};
+
+		should("reset clears all counters") = [] {
+			go::make_error<error_counted>();
+			go::is_error(go::make_error<error_counted>(), go::make_error<error_other>());
+
+			go::reset_metrics();
+
+			auto snapshot = go::snapshot_metrics();
+			expect(snapshot.created.empty());
+			expect(snapshot.traversal_depth.total() == 0_ul);
+		};
+
+		should("resets aren't lost while other threads count") = [] {
+			std::atomic<std::uint64_t> createdSoFar{0};
+			std::atomic<bool> stop{false};
+
+			std::thread worker([&] {
+				while (!stop.load())
+				{
+					go::make_error<error_other>();
+					createdSoFar++;
+				}
+			});
+
+			std::uint64_t before = 0;
+			for (int i = 0; i < 100; i++)
+			{
+				while (createdSoFar.load() < before + 100)
+					std::this_thread::yield();
+
+				before = createdSoFar.load();
+				go::reset_metrics();
+			}
+
+			stop = true;
+			worker.join();
+
+			// Only errors created after the last reset may be counted
+			auto counted = created(go::snapshot_metrics(), "error_other_data");
+			expect(counted <= createdSoFar.load() - before) << "got" << counted << "want at most" << createdSoFar.load() - before;
+		};
+	};
+
+	"metrics_histogram"_test = [] {
+		expect(go::metrics_histogram::bucket_of(0) == 0_ul);
+		expect(go::metrics_histogram::bucket_of(1) == 1_ul);
+		expect(go::metrics_histogram::bucket_of(2) == 2_ul);
+		expect(go::metrics_histogram::bucket_of(3) == 2_ul);
+		expect(go::metrics_histogram::bucket_of(4) == 3_ul);
+		expect(go::metrics_histogram::bucket_upper_bound(3) == 7_ul);
+		expect(go::metrics_histogram::bucket_of(~std::uint64_t(0)) == go::metrics_histogram::bucket_count - 1);
+	};
+
+	return 0;
+}
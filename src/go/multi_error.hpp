@@ -0,0 +1,309 @@
+#pragma once
+
+#include <go/error.hpp>
+#include <go/hash.hpp>
+#include <go/memoize.hpp>
+#include <go/render.hpp>
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace go
+{
+    /*! \addtogroup predefined Predefined errors
+     * @{
+     */
+
+    /// Error data for `go::error_multi`, a list of errors reported together.
+    /*!
+     * Follows hashicorp/go-multierror: the message is a count followed by
+     * a bulleted list of the messages of the errors, and `unwrap_multiple`
+     * returns the errors, so `go::is_error` and `go::as_error` look into
+     * each of them in order. The message is memoized until the list is extended.
+     *
+     * ```
+     * 2 errors occurred:
+     *     * port is out of range
+     *     * name is empty
+     * ```
+     */
+    struct error_multi_data : public error_interface, public hashable_interface, public memoized_message,
+        public composite_message_interface
+    {
+        /// Initialized with a list of errors.
+        explicit error_multi_data(std::vector<error> errs) :
+            errs_(std::move(errs))
+        {}
+
+        /// Returns the errors of the list.
+        auto errors() const -> std::vector<error> const&
+        {
+            return errs_;
+        }
+
+        /// Returns the number of errors followed by the bulleted list of their messages.
+        auto message() const -> std::string override
+        {
+            return std::string(message_view());
+        }
+
+        /// Returns the errors of the list.
+        auto unwrap_multiple() const -> std::vector<error> const& override
+        {
+            return errs_;
+        }
+
+        /// The count, then every error's message on its own bulleted line.
+        auto message_layout() const -> go::message_layout override
+        {
+            std::string prefix = std::to_string(errs_.size());
+            prefix += errs_.size() == 1 ? " error occurred:\n" : " errors occurred:\n";
+            return {std::move(prefix), "\t* ", {}, "\n", "\n"};
+        }
+
+        /// Lists have no value of their own, only their errors are compared.
+        /*!
+         * The hash of the tree isn't cached, as `go::append_error` may extend
+         * a list in place.
+         */
+        auto hash() const noexcept -> std::size_t override
+        {
+            return 0;
+        }
+
+        /// Always true, only the errors of the lists are compared.
+        auto equals(error_interface const&) const noexcept -> bool override
+        {
+            return true;
+        }
+
+    protected:
+        auto render_message() const -> std::string override
+        {
+            std::string msg = std::to_string(errs_.size());
+            msg += errs_.size() == 1 ? " error occurred:\n" : " errors occurred:\n";
+
+            for (auto& err : errs_)
+            {
+                msg += "\t* ";
+                append_message(msg, err);
+                msg += '\n';
+            }
+
+            msg += '\n';
+            return msg;
+        }
+
+    private:
+        std::vector<error> errs_;
+
+        template <class... Errors>
+        friend auto append_error(error err, Errors&&... errs) -> error;
+    };
+
+    /// A list of errors, as created by `go::append_error`.
+    /*!
+     * Refer to `go::error_multi_data` for behavior details.
+     */
+    using error_multi = error_of<error_multi_data>;
+
+    /// Error data for `go::error_join`, errors joined by `go::join_errors`.
+    /*!
+     * Follows Go's errors.Join: the message is the messages of the errors separated
+     * by newlines, memoized after the first call. The errors are kept in an inline array of up to N errors instead
+     * of a vector, so joining takes a single allocation. `unwrap_multiple` copies
+     * them into a vector on first use, `unwrap_span` views them in place.
+     */
+    template <std::size_t N>
+    struct error_join_data : public error_interface, public hashable_interface, public memoized_message,
+        public composite_message_interface
+    {
+        /// Initialized with up to N errors, empty errors are skipped.
+        template <class... Errors>
+        explicit error_join_data(Errors&&... errs)
+        {
+            static_assert(sizeof...(Errors) <= N, "error_join_data expects at most N errors");
+            (add(std::forward<Errors>(errs)), ...);
+        }
+
+        /// Returns the joined errors.
+        auto errors() const noexcept -> error_span
+        {
+            return {errs_.data(), size_};
+        }
+
+        /// Returns the messages of the errors separated by newlines.
+        auto message() const -> std::string override
+        {
+            return std::string(message_view());
+        }
+
+        /// Returns the joined errors.
+        auto unwrap_span() const -> error_span override
+        {
+            return errors();
+        }
+
+        /// Returns a copy of the joined errors, made on the first call.
+        auto unwrap_multiple() const -> std::vector<error> const& override
+        {
+            return multiple_.get(errors());
+        }
+
+        /// The messages of the errors separated by newlines.
+        auto message_layout() const -> go::message_layout override
+        {
+            return {{}, {}, "\n", {}, {}};
+        }
+
+        /// Joins have no value of their own, only their errors are compared.
+        auto hash() const noexcept -> std::size_t override
+        {
+            return 0;
+        }
+
+        /// Always true, only the joined errors are compared.
+        auto equals(error_interface const&) const noexcept -> bool override
+        {
+            return true;
+        }
+
+    protected:
+        /// Joins are immutable, so the hash of their tree is cached.
+        auto tree_hash_cacheable() const noexcept -> bool override
+        {
+            return true;
+        }
+
+        auto render_message() const -> std::string override
+        {
+            std::string msg;
+            for (std::size_t i = 0; i < size_; i++)
+            {
+                if (i != 0)
+                    msg += '\n';
+
+                append_message(msg, errs_[i]);
+            }
+
+            return msg;
+        }
+
+    private:
+        template <class Error>
+        auto add(Error&& err) -> void
+        {
+            if (err)
+                errs_[size_++] = std::forward<Error>(err);
+        }
+
+        std::array<error, N> errs_;
+        std::size_t size_ = 0;
+        detail::unwrap_multiple_cache multiple_;
+    };
+
+    /// Errors joined by `go::join_errors`.
+    /*!
+     * Refer to `go::error_join_data` for behavior details.
+     */
+    template <std::size_t N>
+    using error_join = error_of<error_join_data<N>>;
+
+    /*! @} */
+
+    /*! \addtogroup wrapping
+     * @{
+     */
+
+    /// Appends errs to err, returning a `go::error_multi`.
+    /*!
+     * When err is already a `go::error_multi` the errors are added to its list,
+     * otherwise err becomes the first error of a new list. Errors in errs that are
+     * lists themselves are flattened into the result, and empty errors are skipped.
+     * Returns an empty error if all errors are empty.
+     *
+     * Like `go::wrap_error`, the list is extended in place when the passed err is
+     * the only reference to it, so collecting errors in a loop doesn't copy:
+     *
+     * ```
+     * go::error result;
+     * for (auto& field : fields)
+     *     result = go::append_error(std::move(result), validate(field));
+     * ```
+     */
+    template <class... Errors>
+    auto append_error(error err, Errors&&... errs) -> error
+    {
+        static_assert((std::is_convertible_v<Errors, error> && ...), "append_error expects errors");
+
+        auto data = err.data();
+        err = {};
+
+        auto multi = std::dynamic_pointer_cast<error_multi_data>(data);
+        if (multi && multi.use_count() == 2)
+            data = {};
+
+        std::shared_ptr<error_multi_data> result;
+        if (multi && !data)
+        {
+            // Nobody else can read the message of a list that is only referenced here
+            result = std::move(multi);
+            result->reset_message();
+        }
+        else
+        {
+            std::vector<error> list;
+            if (multi)
+                list = multi->errors();
+            else if (data)
+                list.push_back(error(std::move(data)));
+
+            result = make_error<error_multi>(std::move(list)).data();
+        }
+
+        // Unused if errs is empty
+        [[maybe_unused]] auto add = [&](error const& e)
+        {
+            if (!e)
+                return;
+
+            if (auto nested = dynamic_cast<error_multi_data const*>(e.data().get()))
+                result->errs_.insert(result->errs_.end(), nested->errs_.begin(), nested->errs_.end());
+            else
+                result->errs_.push_back(e);
+        };
+
+        (add(error(std::forward<Errors>(errs))), ...);
+
+        if (result->errs_.empty())
+            return {};
+
+        return error_multi(std::move(result));
+    }
+
+    /// Joins errs into a single `go::error_join`, like Go's errors.Join.
+    /*!
+     * Empty errors are skipped, and an empty error is returned if all errors are empty.
+     * Unlike `go::append_error`, nested joins are kept as they are, and the errors are
+     * stored inline in the joined error, which makes joining a fixed number of errors
+     * cheaper than building a list:
+     *
+     * ```
+     * return go::join_errors(closeErr, flushErr);
+     * ```
+     */
+    template <class... Errors>
+    auto join_errors(Errors&&... errs) -> error
+    {
+        static_assert((std::is_convertible_v<Errors, error> && ...), "join_errors expects errors");
+
+        if ((!errs && ...))
+            return {};
+
+        return make_error<error_join<sizeof...(Errors)>>(error(std::forward<Errors>(errs))...);
+    }
+
+    /*! @} */
+}
@@ -0,0 +1,123 @@
+#include <go/multi_error.hpp>
+#include <go/errorf.hpp>
+#include <go/wrap.hpp>
+#include <go/error_chain.hpp>
+
+#include <boost/ut.hpp>
+using namespace boost::ut;
+
+int main()
+{
+	"append_error"_test = [] {
+		should("message lists all errors") = [] {
+			auto err = go::append_error(go::errorf("port is out of range"), go::errorf("name is empty"));
+
+			expect(err.message() == "2 errors occurred:\n\t* port is out of range\n\t* name is empty\n\n")
+				<< "got" << err.message();
+
+			auto single = go::append_error(go::errorf("name is empty"));
+			expect(single.message() == "1 error occurred:\n\t* name is empty\n\n") << "got" << single.message();
+		};
+
+		should("is_error looks into every error") = [] {
+			auto target = go::errorf("target");
+			auto err = go::append_error(go::errorf("a"), go::errorf("b"), target);
+
+			expect(go::is_error(err, target));
+			expect(err.unwrap_multiple().size() == 3_ul);
+		};
+
+		should("empty errors are skipped") = [] {
+			expect(go::append_error(go::error(), go::error()) == false);
+
+			auto err = go::append_error(go::error(), go::errorf("a"), go::error());
+			expect(err.unwrap_multiple().size() == 1_ul);
+		};
+
+		should("lists are flattened") = [] {
+			auto inner = go::append_error(go::errorf("a"), go::errorf("b"));
+			auto err = go::append_error(go::errorf("c"), inner);
+
+			expect(err.unwrap_multiple().size() == 3_ul);
+			expect(inner.unwrap_multiple().size() == 2_ul);
+		};
+
+		should("uniquely owned lists are extended in place") = [] {
+			go::error err;
+			err = go::append_error(std::move(err), go::errorf("a"));
+			auto first = err.data().get();
+
+			err = go::append_error(std::move(err), go::errorf("b"));
+			expect(err.data().get() == first);
+			expect(err.unwrap_multiple().size() == 2_ul);
+		};
+
+		should("shared lists are copied") = [] {
+			auto shared = go::append_error(go::errorf("a"));
+			auto err = go::append_error(shared, go::errorf("b"));
+
+			expect(err.data() != shared.data());
+			expect(shared.unwrap_multiple().size() == 1_ul);
+			expect(err.unwrap_multiple().size() == 2_ul);
+		};
+
+		should("unwrap_span views the list") = [] {
+			auto err = go::append_error(go::errorf("a"), go::errorf("b"));
+
+			auto span = err.unwrap_span();
+			expect(span.size() == 2_ul);
+			expect(span.data() == err.unwrap_multiple().data());
+		};
+	};
+
+	"join_errors"_test = [] {
+		should("message joins messages with newlines") = [] {
+			auto err = go::join_errors(go::errorf("port is out of range"), go::errorf("name is empty"));
+			expect(err.message() == "port is out of range\nname is empty") << "got" << err.message();
+		};
+
+		should("errors are exposed through unwrap_span and unwrap_multiple") = [] {
+			auto a = go::errorf("a");
+			auto b = go::errorf("b");
+			auto err = go::join_errors(a, b);
+
+			auto span = err.unwrap_span();
+			expect(span.size() == 2_ul);
+			expect(span[0] == a);
+			expect(span[1] == b);
+
+			auto& multiple = err.unwrap_multiple();
+			expect(multiple.size() == 2_ul);
+			expect(multiple[0] == a);
+			expect(multiple[1] == b);
+			expect(&err.unwrap_multiple() == &multiple);
+		};
+
+		should("is_error and as_error look into every error") = [] {
+			auto target = go::errorf("target");
+			auto err = go::join_errors(go::errorf("a"), go::wrap_error(target, "context"));
+
+			expect(go::is_error(err, target));
+			expect(!go::is_error(err, go::errorf("target")));
+		};
+
+		should("empty errors are skipped") = [] {
+			expect(!go::join_errors());
+			expect(!go::join_errors(go::error(), go::error()));
+
+			auto err = go::join_errors(go::error(), go::errorf("a"), go::error());
+			expect(err.unwrap_span().size() == 1_ul);
+			expect(err.message() == "a") << "got" << err.message();
+		};
+
+		should("nested joins are kept") = [] {
+			auto inner = go::join_errors(go::errorf("a"), go::errorf("b"));
+			auto err = go::join_errors(inner, go::errorf("c"));
+
+			expect(err.unwrap_span().size() == 2_ul);
+			expect(err.message() == "a\nb\nc") << "got" << err.message();
+		};
+	};
+
+	return 0;
+}
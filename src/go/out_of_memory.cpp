@@ -0,0 +1,30 @@
+#include <go/out_of_memory.hpp>
+#include <go/detail/demangle.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace go
+{
+    error_out_of_memory_data::error_out_of_memory_data(std::type_info const& type) noexcept :
+        type_(type)
+    {
+        auto append = [this](std::string_view text)
+        {
+            auto size = std::min(text.size(), max_message_size - size_);
+            std::memcpy(message_ + size_, text.data(), size);
+            size_ += size;
+        };
+
+        append("out of memory while creating ");
+
+        try
+        {
+            append(detail::demangle(type.name()));
+        }
+        catch (std::bad_alloc const&)
+        {
+            append(type.name());
+        }
+    }
+}
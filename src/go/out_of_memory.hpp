@@ -0,0 +1,144 @@
+#pragma once
+
+#include <go/error.hpp>
+
+#include <cstddef>
+#include <new>
+#include <string_view>
+#include <typeinfo>
+#include <utility>
+
+namespace go
+{
+    /*! \addtogroup predefined Predefined errors
+     * @{
+     */
+
+    /// Error data for `go::error_out_of_memory`, returned by `go::try_make_error`
+    /// when the error it was asked to create couldn't be allocated.
+    /*!
+     * There is a single immortal instance per error data type, which lives in static
+     * storage and isn't reference counted, so returning it never allocates.
+     *
+     * The message is built once into a fixed buffer when the instance is created, on
+     * the first `go::try_make_error` call for the type. `message_view` reads it without
+     * allocating, while `message` copies it into a `std::string`, which allocates.
+     */
+    struct error_out_of_memory_data : public error_interface
+    {
+        /// Size of the message buffer. Longer messages are cut.
+        static constexpr std::size_t max_message_size = 256;
+
+        /// Initialized with the type of the error data that couldn't be created. Uses the
+        /// mangled name of the type if demangling it fails to allocate.
+        explicit error_out_of_memory_data(std::type_info const& type) noexcept;
+
+        /// Returns the type of the error data that couldn't be created.
+        auto type() const noexcept -> std::type_info const&
+        {
+            return type_;
+        }
+
+        /// Returns "out of memory while creating " followed by the name of the type.
+        auto message_view() const noexcept -> std::string_view
+        {
+            return {message_, size_};
+        }
+
+        /// Returns a copy of `message_view`.
+        auto message() const -> std::string override
+        {
+            return std::string(message_view());
+        }
+
+    private:
+        std::type_info const& type_;
+        char message_[max_message_size];
+        std::size_t size_ = 0;
+    };
+
+    /// Returned by `go::try_make_error` when allocation fails.
+    /*!
+     * Refer to `go::error_out_of_memory_data` for behavior details.
+     */
+    using error_out_of_memory = error_of<error_out_of_memory_data>;
+
+    /*! @} */
+
+    /// \cond TEMPLATE_DETAILS
+    namespace detail
+    {
+        /// Returns the immortal out of memory error data for Impl.
+        template <class Impl>
+        auto out_of_memory_data() noexcept -> error_out_of_memory_data&
+        {
+            static error_out_of_memory_data instance(typeid(Impl));
+            return instance;
+        }
+
+        /// Returns the immortal out of memory error for Impl. It is shared through the
+        /// aliasing constructor without an owner, so it has no control block to allocate.
+        template <class Impl>
+        auto out_of_memory_error() noexcept -> error_out_of_memory
+        {
+            return error_out_of_memory(std::shared_ptr<error_out_of_memory_data>(std::shared_ptr<void>(), &out_of_memory_data<Impl>()));
+        }
+
+        template <class ErrorType>
+        struct try_make_error_impl
+        {
+            static_assert(always_false<ErrorType>::value, "ErrorType should a valid go::error_of<T>");
+        };
+
+        template <class Impl>
+        struct try_make_error_impl<error_of<Impl>>
+        {
+            template <class... Args>
+            static auto make(Args&&... args) noexcept -> error
+            {
+                // Builds the message before it is needed, while memory is likely available
+                out_of_memory_data<Impl>();
+
+                try
+                {
+                    return make_error<error_of<Impl>>(std::forward<Args>(args)...);
+                }
+                catch (std::bad_alloc const&)
+                {
+                    return out_of_memory_error<Impl>();
+                }
+            }
+        };
+    } // namespace detail
+    /// \endcond
+
+    /*! \addtogroup core
+     * @{
+     */
+
+    /// Like `go::make_error`, but returns a `go::error_out_of_memory` instead of
+    /// throwing `std::bad_alloc`.
+    /*!
+     * The error path keeps working under memory pressure: the out of memory error
+     * of each error data type is preallocated in static storage and is returned
+     * without allocating.
+     *
+     * ```
+     * auto err = go::try_make_error<error_parse>(line);
+     *
+     * go::error_out_of_memory oom;
+     * if (go::as_error(err, oom))
+     *     shed_load();
+     * ```
+     *
+     * Exceptions other than `std::bad_alloc` thrown by the error data's constructor
+     * terminate the program.
+     */
+    template <class ErrorType, class... Args>
+    auto try_make_error(Args&&... args) noexcept -> error
+    {
+        return detail::try_make_error_impl<ErrorType>::make(std::forward<Args>(args)...);
+    }
+
+    /*! @} */
+}
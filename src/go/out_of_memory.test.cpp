@@ -0,0 +1,150 @@
+#include <go/out_of_memory.hpp>
+#include <go/error_string.hpp>
+#include <go/wrap.hpp>
+
+#include <boost/ut.hpp>
+using namespace boost::ut;
+
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+// Fault-injecting allocator: replaces the global operator new of the test program,
+// so that allocations made by the library can be made to fail on demand.
+long allocationsLeft = -1;
+long allocations = 0;
+
+void* operator new(std::size_t size)
+{
+	if (allocationsLeft == 0)
+		throw std::bad_alloc();
+
+	if (allocationsLeft > 0)
+		allocationsLeft--;
+
+	allocations++;
+	if (auto p = std::malloc(size ? size : 1))
+		return p;
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+// Lets the given number of allocations succeed and fails the following ones
+struct failing_allocations
+{
+	explicit failing_allocations(long succeeding)
+	{
+		allocationsLeft = succeeding;
+		allocations = 0;
+	}
+
+	~failing_allocations()
+	{
+		allocationsLeft = -1;
+	}
+};
+
+// Allocates in its constructor, after the error itself was allocated
+struct error_buffered_data : public go::error_interface
+{
+	explicit error_buffered_data(std::size_t size) :
+		buffer(size)
+	{}
+
+	std::string message() const override
+	{
+		return "buffered";
+	}
+
+	std::vector<char> buffer;
+};
+
+using error_buffered = go::error_of<error_buffered_data>;
+
+int main()
+{
+	"try_make_error"_test = [] {
+		should("create the error when allocation succeeds") = [] {
+			auto err = go::try_make_error<go::error_string>(std::string("failed"));
+
+			go::error_string str;
+			expect(go::as_error(err, str));
+			expect(err.message() == "failed");
+		};
+
+		should("return the out of memory error when allocation fails") = [] {
+			std::string msg = "failed";
+
+			go::error err;
+			{
+				failing_allocations failing(0);
+				err = go::try_make_error<go::error_string>(msg);
+			}
+
+			go::error_out_of_memory oom;
+			expect(go::as_error(err, oom));
+			expect(oom->type() == typeid(go::error_string_data));
+			expect(err.message() == "out of memory while creating go::error_string_data") << "got" << err.message();
+		};
+
+		should("not allocate when allocation fails") = [] {
+			failing_allocations failing(0);
+
+			auto err = go::try_make_error<go::error_string>(std::string());
+			auto copy = err;
+			copy = {};
+			err = {};
+
+			expect(allocations == 0_l);
+		};
+
+		should("fail when the error data's constructor fails to allocate") = [] {
+			go::error err;
+			{
+				failing_allocations failing(1);
+				err = go::try_make_error<error_buffered>(std::size_t(1024));
+			}
+
+			go::error_out_of_memory oom;
+			expect(go::as_error(err, oom));
+			expect(oom->type() == typeid(error_buffered_data));
+		};
+
+		should("read the message without allocating") = [] {
+			go::try_make_error<error_buffered>(std::size_t(0));
+
+			failing_allocations failing(0);
+			auto err = go::try_make_error<error_buffered>(std::size_t(0));
+
+			go::error_out_of_memory oom;
+			expect(go::as_error(err, oom));
+			expect(oom->message_view() == "out of memory while creating error_buffered_data");
+			expect(allocations == 0_l);
+		};
+
+		should("return the same immortal error per type") = [] {
+			failing_allocations failing(0);
+
+			auto a = go::try_make_error<go::error_string>(std::string());
+			auto b = go::try_make_error<go::error_string>(std::string());
+			auto c = go::try_make_error<error_buffered>(std::size_t(0));
+
+			expect(a == b);
+			expect(a != c);
+			expect(a.data().use_count() == 0_l);
+		};
+	};
+
+	return 0;
+}
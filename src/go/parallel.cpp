@@ -0,0 +1,318 @@
+#include <go/parallel.hpp>
+#include <go/memoize.hpp>
+#include <go/render.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace go
+{
+    namespace detail
+    {
+        // A run call whose tasks the threads of the pool take indices from
+        struct pool_job
+        {
+            std::function<void(std::size_t)> const& task;
+            std::size_t count;
+            std::size_t next = 0;
+            std::size_t finished = 0;
+
+            // The first exception thrown by task
+            std::exception_ptr exception;
+        };
+
+        struct thread_pool_state
+        {
+            std::mutex mutex;
+            std::condition_variable wake;
+            std::condition_variable done;
+
+            // Jobs that still have indices left, the oldest first
+            std::deque<pool_job*> jobs;
+            bool stopping = false;
+
+            std::vector<std::thread> threads;
+
+            // Takes the next index of the oldest job, or returns null if there are no jobs
+            auto claim(std::size_t& index) -> pool_job*
+            {
+                while (!jobs.empty())
+                {
+                    auto job = jobs.front();
+                    if (job->next < job->count)
+                    {
+                        index = job->next++;
+                        return job;
+                    }
+
+                    jobs.pop_front();
+                }
+
+                return nullptr;
+            }
+
+            // Runs a claimed index of job, with lock held before and after
+            auto execute(std::unique_lock<std::mutex>& lock, pool_job& job, std::size_t index) -> void
+            {
+                std::exception_ptr exception;
+
+                lock.unlock();
+                try
+                {
+                    job.task(index);
+                }
+                catch (...)
+                {
+                    exception = std::current_exception();
+                }
+                lock.lock();
+
+                // The indices nobody claimed yet are dropped, the caller rethrows once the
+                // running ones returned
+                if (exception)
+                {
+                    if (!job.exception)
+                        job.exception = std::move(exception);
+
+                    job.finished += job.count - job.next;
+                    job.next = job.count;
+                }
+
+                if (++job.finished == job.count)
+                    done.notify_all();
+            }
+
+            auto work() -> void
+            {
+                std::unique_lock lock(mutex);
+                while (true)
+                {
+                    std::size_t index;
+                    auto job = claim(index);
+                    if (!job)
+                    {
+                        if (stopping)
+                            return;
+
+                        wake.wait(lock);
+                        continue;
+                    }
+
+                    execute(lock, *job, index);
+                }
+            }
+        };
+    }
+
+    thread_pool::thread_pool(std::size_t threads) :
+        state_(std::make_unique<detail::thread_pool_state>())
+    {
+        for (std::size_t i = 1; i < threads; i++)
+            state_->threads.emplace_back([state = state_.get()] { state->work(); });
+    }
+
+    thread_pool::~thread_pool()
+    {
+        {
+            std::lock_guard lock(state_->mutex);
+            state_->stopping = true;
+        }
+
+        state_->wake.notify_all();
+        for (auto& thread : state_->threads)
+            thread.join();
+    }
+
+    auto thread_pool::size() const -> std::size_t
+    {
+        return state_->threads.size() + 1;
+    }
+
+    auto thread_pool::run(std::size_t count, std::function<void(std::size_t)> const& task) -> void
+    {
+        if (count == 0)
+            return;
+
+        if (state_->threads.empty() || count == 1)
+        {
+            for (std::size_t i = 0; i < count; i++)
+                task(i);
+
+            return;
+        }
+
+        detail::pool_job job{task, count, 0, 0, {}};
+
+        std::unique_lock lock(state_->mutex);
+        state_->jobs.push_back(&job);
+        state_->wake.notify_all();
+
+        // Work on the job until all of its indices are taken, then wait for the other threads
+        while (job.next < job.count)
+            state_->execute(lock, job, job.next++);
+
+        state_->done.wait(lock, [&] { return job.finished == job.count; });
+
+        // Other threads only reach the job through the queue, while holding the lock
+        auto it = std::find(state_->jobs.begin(), state_->jobs.end(), &job);
+        if (it != state_->jobs.end())
+            state_->jobs.erase(it);
+
+        lock.unlock();
+        if (job.exception)
+            std::rethrow_exception(job.exception);
+    }
+
+    auto thread_pool::default_size() -> std::size_t
+    {
+        return std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    namespace
+    {
+        // Number of chunks to split size errors into
+        auto chunk_count(std::size_t size, thread_pool const& pool, parallel_options const& options) -> std::size_t
+        {
+            return std::clamp<std::size_t>(pool.size() * options.chunks_per_thread, 1, size);
+        }
+
+        // Index of the first error of chunk out of chunks
+        auto chunk_begin(std::size_t chunk, std::size_t chunks, std::size_t size) -> std::size_t
+        {
+            return size / chunks * chunk + std::min(chunk, size % chunks);
+        }
+
+        auto saturating_sub(std::size_t value, std::size_t sub) -> std::size_t
+        {
+            return value > sub ? value - sub : 0;
+        }
+    }
+
+    namespace detail
+    {
+        auto parallel_find_first(error_span errs, thread_pool& pool, parallel_options const& options,
+            std::function<bool(error const&)> const& match) -> std::size_t
+        {
+            auto chunks = chunk_count(errs.size(), pool, options);
+
+            // Lowest index of a matching error found so far
+            std::atomic<std::size_t> first{errs.size()};
+
+            pool.run(chunks, [&](std::size_t chunk)
+            {
+                auto end = chunk_begin(chunk + 1, chunks, errs.size());
+                for (auto i = chunk_begin(chunk, chunks, errs.size()); i < end; i++)
+                {
+                    // An earlier error matched, the rest of the chunk can't win
+                    if (i > first.load(std::memory_order_relaxed))
+                        return;
+
+                    if (match(errs[i]))
+                    {
+                        auto current = first.load(std::memory_order_relaxed);
+                        while (i < current && !first.compare_exchange_weak(current, i, std::memory_order_relaxed))
+                        {}
+
+                        return;
+                    }
+                }
+            });
+
+            return first.load(std::memory_order_relaxed);
+        }
+
+        auto traversal_below(traversal_options const& options, std::size_t depth) -> traversal_options
+        {
+            traversal_options below = options;
+            below.cycle_check_depth = saturating_sub(options.cycle_check_depth, depth);
+            below.max_depth = saturating_sub(options.max_depth, depth);
+            below.max_nodes = saturating_sub(options.max_nodes, depth);
+            return below;
+        }
+    }
+
+    auto parallel_message(error const& err, thread_pool& pool, parallel_options const& options) -> std::string
+    {
+        std::string msg;
+
+        // Text that closes the layouts of the chain, innermost last
+        std::vector<std::string> closing;
+
+        error owned;
+        error const* node = &err;
+        while (true)
+        {
+            auto memoized = dynamic_cast<memoized_message const*>(node->operator->());
+            auto composite = dynamic_cast<composite_message_interface const*>(node->operator->());
+            if (!*node || !composite || (memoized && memoized->has_cached_message()))
+            {
+                append_message(msg, *node);
+                break;
+            }
+
+            auto unwrapped = node->unwrap();
+            if (unwrapped)
+            {
+                auto layout = composite->message_layout();
+                msg += layout.prefix;
+                msg += layout.before_each;
+                closing.emplace_back(layout.after_each);
+                closing.back() += layout.suffix;
+
+                owned = std::move(unwrapped);
+                node = &owned;
+                continue;
+            }
+
+            auto errs = node->unwrap_span();
+            if (errs.size() < options.min_fanout || pool.size() == 1)
+            {
+                append_message(msg, *node);
+                break;
+            }
+
+            auto layout = composite->message_layout();
+            auto chunks = chunk_count(errs.size(), pool, options);
+            std::vector<std::string> rendered(chunks);
+
+            pool.run(chunks, [&](std::size_t chunk)
+            {
+                auto& out = rendered[chunk];
+                auto end = chunk_begin(chunk + 1, chunks, errs.size());
+                for (auto i = chunk_begin(chunk, chunks, errs.size()); i < end; i++)
+                {
+                    if (i != 0)
+                        out += layout.between;
+
+                    out += layout.before_each;
+                    append_message(out, errs[i]);
+                    out += layout.after_each;
+                }
+            });
+
+            std::size_t size = msg.size() + layout.prefix.size() + layout.suffix.size();
+            for (auto& out : rendered)
+                size += out.size();
+
+            msg.reserve(size);
+            msg += layout.prefix;
+            for (auto& out : rendered)
+                msg += out;
+
+            msg += layout.suffix;
+            break;
+        }
+
+        for (auto it = closing.rbegin(); it != closing.rend(); ++it)
+            msg += *it;
+
+        return msg;
+    }
+}
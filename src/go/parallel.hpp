@@ -0,0 +1,223 @@
+#pragma once
+
+#include <go/error.hpp>
+#include <go/wrap.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+namespace go
+{
+    /// \cond TEMPLATE_DETAILS
+    namespace detail
+    {
+        struct thread_pool_state;
+    }
+    /// \endcond
+
+    /*! \addtogroup wrapping
+     * @{
+     */
+
+    /// Fixed set of threads that the parallel traversals split their work across.
+    /*!
+     * The thread calling `run` works on the tasks too, so a pool of size N starts
+     * N - 1 threads and a pool of size 1 runs everything on the calling thread.
+     * Several threads may run tasks on the same pool at once, including tasks that
+     * run tasks of their own.
+     */
+    class thread_pool
+    {
+    public:
+        /// Starts threads - 1 threads, at least one thread always runs tasks.
+        explicit thread_pool(std::size_t threads = default_size());
+
+        /// Stops the threads, expects no running `run` calls.
+        ~thread_pool();
+
+        thread_pool(thread_pool const&) = delete;
+        thread_pool& operator=(thread_pool const&) = delete;
+
+        /// Returns the number of threads that run tasks, the calling thread included.
+        auto size() const -> std::size_t;
+
+        /// Calls task with every index in [0, count) across the threads of the pool and
+        /// returns once all calls returned.
+        /*!
+         * If task throws, the indices that no thread started yet are skipped, and the
+         * first exception is rethrown on the calling thread once the running calls
+         * returned. The pool stays usable.
+         */
+        auto run(std::size_t count, std::function<void(std::size_t)> const& task) -> void;
+
+        /// Returns the number of hardware threads, or 1 if unknown.
+        static auto default_size() -> std::size_t;
+
+    private:
+        std::unique_ptr<detail::thread_pool_state> state_;
+    };
+
+    /// Decides when the parallel traversals split a list of errors across threads.
+    struct parallel_options
+    {
+        /// Lists that wrap fewer errors are traversed on the calling thread.
+        std::size_t min_fanout = 1024;
+
+        /// Number of pieces a list is split into per thread of the pool. More pieces
+        /// balance uneven subtrees better, fewer ones cost less to schedule.
+        std::size_t chunks_per_thread = 4;
+
+        /// Limits of the traversal, refer to `go::traversal_options`.
+        traversal_options traversal;
+    };
+
+    /*! @} */
+
+    /// \cond TEMPLATE_DETAILS
+    namespace detail
+    {
+        /// Returns the index of the first error of errs that match returns true for, or
+        /// errs.size() if there is none. Calls match concurrently on the threads of pool.
+        auto parallel_find_first(error_span errs, thread_pool& pool, parallel_options const& options,
+            std::function<bool(error const&)> const& match) -> std::size_t;
+
+        /// Returns the limits left for the tree of an error at depth, below a chain of
+        /// depth errors that were already visited.
+        auto traversal_below(traversal_options const& options, std::size_t depth) -> traversal_options;
+
+        /*! \brief Visits err's tree in the order of `go::detail::wrapping_impl::walk`, and returns
+         *  true as soon as visit returns true for an error.
+         *
+         *  The chain of errors reached through unwrap is followed on the calling thread. The
+         *  first list of at least min_fanout errors is split across pool: probe is called
+         *  concurrently on the subtrees of its errors, and visit walks the first subtree that
+         *  probe found a match in again, so that only the calling thread calls visit.
+         */
+        template <class Visitor, class Probe>
+        auto parallel_walk(error const& err, thread_pool& pool, parallel_options const& options, Visitor&& visit, Probe&& probe) -> bool
+        {
+            auto const& limits = options.traversal;
+
+            error owned;
+            error const* node = &err;
+            for (std::size_t depth = 0; *node; depth++)
+            {
+                auto unwrapped = node->unwrap();
+                auto errs = unwrapped ? error_span() : node->unwrap_span();
+                auto wide = !unwrapped && errs.size() >= options.min_fanout && pool.size() > 1;
+
+                if (depth >= limits.max_nodes)
+                    return false;
+
+                // Cycles are only detected by walk, it is past this depth that they are checked for
+                if ((!wide && !unwrapped) || depth >= limits.cycle_check_depth)
+                    return wrapping_impl::walk(*node, traversal_below(limits, depth), visit);
+
+                if (visit(*node))
+                    return true;
+
+                if (depth == limits.max_depth)
+                    return false;
+
+                if (unwrapped)
+                {
+                    owned = std::move(unwrapped);
+                    node = &owned;
+                    continue;
+                }
+
+                auto childLimits = traversal_below(limits, depth + 1);
+                auto first = parallel_find_first(errs, pool, options, [&](error const& child)
+                {
+                    return wrapping_impl::walk(child, childLimits, probe);
+                });
+
+                return first != errs.size() && wrapping_impl::walk(errs[first], childLimits, visit);
+            }
+
+            return false;
+        }
+    } // namespace detail
+    /// \endcond
+
+    /*! \addtogroup wrapping
+     * @{
+     */
+
+    /// `go::is_error` that splits the errors of a wide list across the threads of pool.
+    /*!
+     * Lists of at least options.min_fanout errors, like bulk validation results, are
+     * split into chunks whose subtrees are searched concurrently. Chunks stop as soon
+     * as an error before them is known to match, and the match with the lowest index
+     * wins, so the result is the same as that of `go::is_error`. Narrower trees are
+     * searched on the calling thread.
+     *
+     * `go::is_interface` implementations are called concurrently and must be thread
+     * safe. The limits of options.traversal apply as they do to `go::is_error`, except
+     * that `max_nodes` bounds the subtree of every error of the split list separately.
+     */
+    template <class Against>
+    auto parallel_is_error(error const& err, error_of<Against> const& target, thread_pool& pool,
+        parallel_options const& options = {}) -> bool
+    {
+        if (!err || !target)
+            return !err && !target;
+
+        auto match = [&](error const& node)
+        {
+            return detail::wrapping_impl::is_match(node, target);
+        };
+
+        return detail::parallel_walk(err, pool, options, match, match);
+    }
+
+    /// `go::as_error` that splits the errors of a wide list across the threads of pool.
+    /*!
+     * Searches like `go::parallel_is_error`, and sets target to the same error that
+     * `go::as_error` would. `go::as_interface` implementations are called concurrently
+     * with default constructed targets while searching, and must be thread safe. Only
+     * the calling thread writes target.
+     */
+    template <class To>
+    auto parallel_as_error(error const& err, To& target, thread_pool& pool, parallel_options const& options = {}) -> bool
+    {
+        static_assert(!std::is_const_v<To>, "parallel_as_error modifies target and expects it to be non-const");
+        static_assert(std::is_convertible_v<To, bool>, "parallel_as_error expects target to be convertible to bool");
+        static_assert(std::is_default_constructible_v<To>, "parallel_as_error expects target to be default constructible");
+
+        if (!err)
+            return false;
+
+        auto visit = [&](error const& node)
+        {
+            return detail::wrapping_impl::as_match(node, target);
+        };
+
+        auto probe = [](error const& node)
+        {
+            To candidate{};
+            return detail::wrapping_impl::as_match(node, candidate);
+        };
+
+        return detail::parallel_walk(err, pool, options, visit, probe);
+    }
+
+    /// Returns err's message, rendering the messages of a wide list on the threads of pool.
+    /*!
+     * The chain of errors that implement `go::composite_message_interface` is followed
+     * down to the first list of at least options.min_fanout errors. The list is split
+     * into chunks whose messages are rendered concurrently and then concatenated, with
+     * the text of the enclosing layouts around them. The result equals `err.message()`.
+     *
+     * Messages that are already memoized are used as they are. The parallel rendering
+     * itself isn't memoized, so calling `message` afterwards renders the list again.
+     * `message` of the listed errors is called concurrently and must be thread safe.
+     * Exceptions it throws are rethrown on the calling thread, as by `go::thread_pool::run`.
+     */
+    auto parallel_message(error const& err, thread_pool& pool, parallel_options const& options = {}) -> std::string;
+
+    /*! @} */
+}
@@ -0,0 +1,198 @@
+#include <go/parallel.hpp>
+#include <go/error_chain.hpp>
+#include <go/error_code.hpp>
+#include <go/error_fields.hpp>
+#include <go/errorf.hpp>
+#include <go/multi_error.hpp>
+
+#include <boost/ut.hpp>
+using namespace boost::ut;
+
+#include <atomic>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+auto errTarget = go::errorf("target");
+
+// Fails to render its message
+struct error_unprintable_data : public go::error_interface
+{
+	std::string message() const override { throw std::runtime_error("unprintable"); }
+};
+
+using error_unprintable = go::error_of<error_unprintable_data>;
+
+// A wrapped list of size errors, where make decides the error at every index
+template <class F>
+auto wide_error(std::size_t size, F make) -> go::error
+{
+	go::error list;
+	for (std::size_t i = 0; i < size; i++)
+		list = go::append_error(std::move(list), make(i));
+
+	return go::wrap_error(std::move(list), "validating batch");
+}
+
+auto code_at(std::size_t i) -> go::error
+{
+	return go::make_error<go::error_code>(std::error_code(static_cast<int>(i), std::generic_category()));
+}
+
+int main()
+{
+	go::thread_pool pool(4);
+
+	go::parallel_options options;
+	options.min_fanout = 16;
+
+	"thread_pool"_test = [&] {
+		should("run every task once") = [&] {
+			std::vector<std::atomic<int>> calls(1000);
+			pool.run(calls.size(), [&](std::size_t i) { calls[i]++; });
+
+			for (auto& count : calls)
+				expect(count.load() == 1_i);
+		};
+
+		should("run tasks that run tasks") = [&] {
+			std::atomic<int> calls{0};
+			pool.run(8, [&](std::size_t) {
+				pool.run(8, [&](std::size_t) { calls++; });
+			});
+
+			expect(calls.load() == 64_i);
+		};
+
+		should("rethrow the first exception once running tasks returned") = [&] {
+			std::atomic<int> running{0};
+
+			expect(throws<std::runtime_error>([&] {
+				pool.run(1000, [&](std::size_t i) {
+					running++;
+					if (i % 100 == 7)
+					{
+						running--;
+						throw std::runtime_error("task failed");
+					}
+
+					running--;
+				});
+			}));
+
+			// Every task returned before run did, and the pool still works
+			expect(running.load() == 0_i);
+
+			std::vector<std::atomic<int>> calls(100);
+			pool.run(calls.size(), [&](std::size_t i) { calls[i]++; });
+			for (auto& count : calls)
+				expect(count.load() == 1_i);
+		};
+
+		should("run on the calling thread without workers") = [] {
+			go::thread_pool single(1);
+			expect(single.size() == 1_ul);
+
+			std::size_t sum = 0;
+			single.run(10, [&](std::size_t i) { sum += i; });
+			expect(sum == 45_ul);
+		};
+	};
+
+	"parallel_is_error"_test = [&] {
+		should("find errors of wide lists") = [&] {
+			auto err = wide_error(5000, [](std::size_t i) {
+				return i == 3777 ? go::wrap_error(errTarget, "item") : go::errorf("item ", i, " is invalid");
+			});
+
+			expect(go::parallel_is_error(err, errTarget, pool, options) == true);
+			expect(go::parallel_is_error(err, go::errorf("other"), pool, options) == false);
+			expect(go::parallel_is_error(go::error(), errTarget, pool, options) == false);
+			expect(go::parallel_is_error(go::error(), go::error(), pool, options) == true);
+		};
+
+		should("match narrow trees on the calling thread") = [&] {
+			auto err = go::wrap_error(go::append_error(go::errorf("a"), errTarget), "context");
+
+			expect(go::parallel_is_error(err, errTarget, pool, options) == true);
+			expect(go::parallel_is_error(err, errTarget, pool) == true);
+		};
+
+		should("respect traversal limits") = [&] {
+			auto err = wide_error(100, [](std::size_t i) {
+				return i == 50 ? go::wrap_error(errTarget, "item") : go::errorf("item");
+			});
+
+			auto limited = options;
+			limited.traversal.max_depth = 2;
+			expect(go::parallel_is_error(err, errTarget, pool, limited) == false);
+
+			limited.traversal.max_depth = 3;
+			expect(go::parallel_is_error(err, errTarget, pool, limited) == true);
+		};
+	};
+
+	"parallel_as_error"_test = [&] {
+		should("find the error with the lowest index") = [&] {
+			auto err = wide_error(5000, [](std::size_t i) {
+				return i >= 1234 ? go::wrap_error(code_at(i), "item") : go::errorf("item");
+			});
+
+			go::error_code expected;
+			expect(go::as_error(err, expected) == true);
+
+			for (int i = 0; i < 10; i++)
+			{
+				go::error_code target;
+				expect(go::parallel_as_error(err, target, pool, options) == true);
+				expect(target == expected);
+				expect(target->value() == 1234_i);
+			}
+		};
+
+		should("not set target if nothing matches") = [&] {
+			auto err = wide_error(100, [](std::size_t) { return go::errorf("item"); });
+
+			go::error_code target;
+			expect(go::parallel_as_error(err, target, pool, options) == false);
+			expect(!target);
+		};
+	};
+
+	"parallel_message"_test = [&] {
+		should("equal message") = [&] {
+			auto err = go::with_fields(wide_error(3000, [](std::size_t i) {
+				if (i % 3 == 0)
+					return go::error(go::join_errors(go::errorf("item ", i), go::errorf("joined")));
+
+				return go::errorf("item ", i, " is invalid");
+			}), go::field("batch", 7));
+
+			// Before and after message is memoized
+			auto rendered = go::parallel_message(err, pool, options);
+			expect(rendered == err.message());
+			expect(go::parallel_message(err, pool, options) == rendered);
+		};
+
+		should("rethrow exceptions of listed messages") = [&] {
+			auto err = wide_error(3000, [](std::size_t i) {
+				return i == 2500 ? go::error(go::make_error<error_unprintable>()) : go::errorf("item ", i);
+			});
+
+			expect(throws<std::runtime_error>([&] { go::parallel_message(err, pool, options); }));
+
+			auto fine = wide_error(3000, [](std::size_t i) { return go::errorf("item ", i); });
+			expect(go::parallel_message(fine, pool, options) == fine.message());
+		};
+
+		should("equal message of narrow and plain errors") = [&] {
+			auto narrow = go::wrap_error(go::append_error(go::errorf("a"), go::errorf("b")), "context");
+
+			expect(go::parallel_message(narrow, pool, options) == narrow.message());
+			expect(go::parallel_message(go::errorf("plain"), pool, options) == "plain");
+			expect(go::parallel_message(go::error(), pool, options) == "<nil>");
+		};
+	};
+
+	return 0;
+}
@@ -0,0 +1,270 @@
+#include <go/reclaim.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace go
+{
+    namespace
+    {
+        using released_errors = std::vector<std::shared_ptr<error_interface>>;
+
+        // Stack of errors waiting to be destroyed. Chains only ever queue a single
+        // error at a time, so the first few are kept inline to avoid allocating
+        class release_stack
+        {
+        public:
+            release_stack() = default;
+
+            explicit release_stack(released_errors errs) :
+                spill_(std::move(errs))
+            {}
+
+            auto empty() const noexcept -> bool
+            {
+                return size_ == 0 && spill_.empty();
+            }
+
+            auto push(std::shared_ptr<error_interface>&& data) -> void
+            {
+                if (size_ < inline_capacity)
+                    inline_[size_++] = std::move(data);
+                else
+                    spill_.push_back(std::move(data));
+            }
+
+            auto pop() noexcept -> std::shared_ptr<error_interface>
+            {
+                if (spill_.empty())
+                    return std::move(inline_[--size_]);
+
+                auto data = std::move(spill_.back());
+                spill_.pop_back();
+                return data;
+            }
+
+            // Moves all queued errors out
+            auto take() -> released_errors
+            {
+                spill_.reserve(spill_.size() + size_);
+                while (size_ > 0)
+                    spill_.push_back(std::move(inline_[--size_]));
+
+                return std::move(spill_);
+            }
+
+        private:
+            static constexpr std::size_t inline_capacity = 8;
+
+            std::shared_ptr<error_interface> inline_[inline_capacity];
+            std::size_t size_ = 0;
+            released_errors spill_;
+        };
+
+        // Errors released while the thread is destroying an error, or null if it isn't.
+        // A plain pointer, so that it is usable in destructors of other thread locals
+        thread_local release_stack* pending = nullptr;
+
+        // Threshold of the active reclaimer, zero if there is none
+        std::atomic<std::size_t> handoffThreshold{0};
+    }
+
+    namespace detail
+    {
+        struct reclaimer_state
+        {
+            std::size_t threshold;
+
+            std::mutex mutex;
+            std::condition_variable wake;
+            std::condition_variable idle;
+            std::vector<released_errors> batches;
+            bool busy = false;
+            bool stopping = false;
+
+            std::atomic<std::size_t> handoffs{0};
+            std::atomic<std::size_t> reclaimed{0};
+
+            std::thread thread;
+
+            auto hand_off(release_stack& errs) -> void
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    batches.emplace_back();
+                    batches.back() = errs.take();
+                }
+
+                handoffs.fetch_add(1, std::memory_order_relaxed);
+                wake.notify_one();
+            }
+
+            auto run() -> void;
+        };
+    }
+
+    namespace
+    {
+        std::mutex activeMutex;
+        detail::reclaimer_state* activeReclaimer = nullptr;
+
+        // Hands errs over to the active reclaimer. Returns false if there is none
+        auto hand_off(release_stack& errs) noexcept -> bool
+        {
+            std::lock_guard<std::mutex> lock(activeMutex);
+            if (!activeReclaimer)
+                return false;
+
+            try
+            {
+                activeReclaimer->hand_off(errs);
+                return true;
+            }
+            catch (...)
+            {
+                return false;
+            }
+        }
+
+        // Destroys errs along with the errors they wrap, one at a time. Returns the
+        // number of destroyed errors. Hands the rest over to the active reclaimer once
+        // its threshold is reached, if handOff is set
+        auto destroy(release_stack& errs, std::size_t destroyed, bool handOff) noexcept -> std::size_t
+        {
+            while (!errs.empty())
+            {
+                if (handOff)
+                {
+                    auto threshold = handoffThreshold.load(std::memory_order_relaxed);
+                    if (threshold && destroyed >= threshold && hand_off(errs))
+                        break;
+                }
+
+                // Wrapped errors released by the destructor are appended to errs
+                errs.pop().reset();
+                destroyed++;
+            }
+
+            return destroyed;
+        }
+    }
+
+    namespace detail
+    {
+        auto release_error(std::shared_ptr<error_interface> data) noexcept -> void
+        {
+            if (pending)
+            {
+                // Destroyed by the outermost release. If there is no memory to queue
+                // the error, it is destroyed right away, recursing one level deeper
+                try
+                {
+                    pending->push(std::move(data));
+                }
+                catch (...)
+                {
+                }
+
+                return;
+            }
+
+            release_stack errs;
+            pending = &errs;
+
+            data.reset();
+            destroy(errs, 1, true);
+
+            pending = nullptr;
+        }
+    }
+
+    auto detail::reclaimer_state::run() -> void
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;)
+        {
+            wake.wait(lock, [&] { return stopping || !batches.empty(); });
+            if (batches.empty())
+                return;
+
+            auto work = std::move(batches);
+            batches.clear();
+            busy = true;
+            lock.unlock();
+
+            // Handed over errors are destroyed as a whole, without handing them over again
+            for (auto& batch : work)
+            {
+                release_stack errs(std::move(batch));
+                pending = &errs;
+                reclaimed.fetch_add(destroy(errs, 0, false), std::memory_order_relaxed);
+                pending = nullptr;
+            }
+
+            work.clear();
+
+            lock.lock();
+            busy = false;
+            idle.notify_all();
+        }
+    }
+
+    background_reclaimer::background_reclaimer(std::size_t threshold) :
+        state_(new detail::reclaimer_state())
+    {
+        state_->threshold = threshold ? threshold : 1;
+        state_->thread = std::thread([s = state_.get()] { s->run(); });
+
+        std::lock_guard<std::mutex> lock(activeMutex);
+        if (!activeReclaimer)
+        {
+            activeReclaimer = state_.get();
+            handoffThreshold.store(state_->threshold, std::memory_order_relaxed);
+        }
+    }
+
+    background_reclaimer::~background_reclaimer()
+    {
+        {
+            std::lock_guard<std::mutex> lock(activeMutex);
+            if (activeReclaimer == state_.get())
+            {
+                activeReclaimer = nullptr;
+                handoffThreshold.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            state_->stopping = true;
+        }
+
+        state_->wake.notify_one();
+        state_->thread.join();
+    }
+
+    auto background_reclaimer::active() const -> bool
+    {
+        std::lock_guard<std::mutex> lock(activeMutex);
+        return activeReclaimer == state_.get();
+    }
+
+    auto background_reclaimer::flush() -> void
+    {
+        std::unique_lock<std::mutex> lock(state_->mutex);
+        state_->idle.wait(lock, [&] { return state_->batches.empty() && !state_->busy; });
+    }
+
+    auto background_reclaimer::handoffs() const -> std::size_t
+    {
+        return state_->handoffs.load(std::memory_order_relaxed);
+    }
+
+    auto background_reclaimer::reclaimed() const -> std::size_t
+    {
+        return state_->reclaimed.load(std::memory_order_relaxed);
+    }
+}
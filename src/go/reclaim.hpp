@@ -0,0 +1,79 @@
+#pragma once
+
+#include <go/error.hpp>
+
+#include <cstddef>
+#include <memory>
+
+namespace go
+{
+    /// \cond TEMPLATE_DETAILS
+    namespace detail
+    {
+        struct reclaimer_state;
+    }
+    /// \endcond
+
+    /*! \addtogroup core
+     * @{
+     */
+
+    /// Thread that destroys large error trees released on other threads.
+    /*!
+     * Errors are always destroyed iteratively: releasing the last reference to an
+     * error queues the errors it wraps instead of destroying them recursively, so
+     * arbitrarily deep chains can't overflow the stack. Destroying a large tree still
+     * takes time proportional to its size, on whichever thread drops it.
+     *
+     * While a reclaimer is active, a thread that has destroyed threshold errors of a
+     * single tree hands the rest of the tree over to the reclaimer's thread, which
+     * bounds the time spent releasing an error on latency sensitive threads:
+     *
+     * ```
+     * int main()
+     * {
+     *     go::background_reclaimer reclaimer;
+     *     ...
+     * }
+     * ```
+     *
+     * Only one reclaimer is active at a time. Reclaimers created while another one is
+     * active stay idle. Destroying the active reclaimer destroys all errors handed
+     * over to it, and later releases destroy everything on the releasing thread again.
+     *
+     * Errors handed over to the reclaimer are destroyed on its thread, so their
+     * destructors must not depend on the thread they run on.
+     */
+    class background_reclaimer
+    {
+    public:
+        /// Default number of errors a thread destroys before handing the rest over.
+        static constexpr std::size_t default_threshold = 1024;
+
+        /// Starts the reclaimer's thread and makes it the active reclaimer, if there is none.
+        explicit background_reclaimer(std::size_t threshold = default_threshold);
+
+        /// Destroys all errors handed over and stops the thread.
+        ~background_reclaimer();
+
+        background_reclaimer(background_reclaimer const&) = delete;
+        background_reclaimer& operator=(background_reclaimer const&) = delete;
+
+        /// True if releases hand errors over to this reclaimer.
+        auto active() const -> bool;
+
+        /// Blocks until all errors handed over so far are destroyed.
+        auto flush() -> void;
+
+        /// Returns the number of times a releasing thread handed errors over.
+        auto handoffs() const -> std::size_t;
+
+        /// Returns the number of errors destroyed on the reclaimer's thread, wrapped errors included.
+        auto reclaimed() const -> std::size_t;
+
+    private:
+        std::unique_ptr<detail::reclaimer_state> state_;
+    };
+
+    /*! @} */
+}
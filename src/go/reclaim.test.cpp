@@ -0,0 +1,180 @@
+#include <go/reclaim.hpp>
+#include <go/error_chain.hpp>
+#include <go/errorf.hpp>
+#include <go/multi_error.hpp>
+
+#include <boost/ut.hpp>
+using namespace boost::ut;
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+std::atomic<long> aliveNodes{0};
+std::atomic<long> nodesDestroyedElsewhere{0};
+std::thread::id testThread;
+
+// Wraps a single error, so that a chain of nodes is as deep as it is long
+struct node_data : public go::error_interface
+{
+	explicit node_data(go::error inner) :
+		inner(std::move(inner))
+	{
+		aliveNodes++;
+	}
+
+	~node_data() override
+	{
+		aliveNodes--;
+		if (std::this_thread::get_id() != testThread)
+			nodesDestroyedElsewhere++;
+	}
+
+	std::string message() const override
+	{
+		return "node";
+	}
+
+	go::error unwrap() const override
+	{
+		return inner;
+	}
+
+	go::error inner;
+};
+
+using node = go::error_of<node_data>;
+
+go::error make_chain(std::size_t depth)
+{
+	go::error err;
+	for (std::size_t i = 0; i < depth; i++)
+		err = go::make_error<node>(std::move(err));
+
+	return err;
+}
+
+int main()
+{
+	testThread = std::this_thread::get_id();
+
+	"iterative release"_test = [] {
+		should("deep chains are destroyed without overflowing the stack") = [] {
+			auto err = make_chain(1000000);
+			expect(aliveNodes.load() == 1000000_l);
+
+			err = {};
+			expect(aliveNodes.load() == 0_l);
+		};
+
+		should("deep chains of shared wrap_error chains are destroyed") = [] {
+			go::error err = go::errorf("root");
+			std::vector<go::error> kept;
+			for (int i = 0; i < 200000; i++)
+			{
+				// Keeping a reference forces every wrap into a new chain block
+				kept.push_back(err);
+				err = go::wrap_error(err, "retry");
+				kept.pop_back();
+			}
+
+			err = {};
+			expect(kept.empty());
+		};
+
+		should("wide lists are destroyed") = [] {
+			go::error err;
+			for (int i = 0; i < 10000; i++)
+				err = go::append_error(std::move(err), make_chain(10));
+
+			expect(aliveNodes.load() == 100000_l);
+			err = {};
+			expect(aliveNodes.load() == 0_l);
+		};
+
+		should("shared errors survive the release of their parent") = [] {
+			auto shared = make_chain(10);
+			auto err = go::make_error<node>(shared);
+
+			err = {};
+			expect(aliveNodes.load() == 10_l);
+			expect(shared.message() == "node");
+
+			shared = {};
+			expect(aliveNodes.load() == 0_l);
+		};
+
+		should("assigning an error owned by the assigned error") = [] {
+			go::error err = make_chain(3);
+			go::error const& inner = static_cast<node_data const&>(*err.operator->()).inner;
+
+			err = inner;
+			expect(aliveNodes.load() == 2_l);
+
+			err = std::move(const_cast<go::error&>(static_cast<node_data const&>(*err.operator->()).inner));
+			expect(aliveNodes.load() == 1_l);
+
+			err = {};
+			expect(aliveNodes.load() == 0_l);
+		};
+	};
+
+	"background_reclaimer"_test = [] {
+		should("large trees are handed over") = [] {
+			go::background_reclaimer reclaimer(100);
+			expect(reclaimer.active());
+
+			nodesDestroyedElsewhere = 0;
+			auto err = make_chain(100000);
+			err = {};
+
+			reclaimer.flush();
+			expect(aliveNodes.load() == 0_l);
+			expect(reclaimer.handoffs() == 1_ul);
+			expect(reclaimer.reclaimed() == 99900_ul) << "got" << reclaimer.reclaimed();
+			expect(nodesDestroyedElsewhere.load() == 99900_l);
+		};
+
+		should("small trees are destroyed on the releasing thread") = [] {
+			go::background_reclaimer reclaimer(100);
+
+			nodesDestroyedElsewhere = 0;
+			auto err = make_chain(50);
+			err = {};
+
+			reclaimer.flush();
+			expect(aliveNodes.load() == 0_l);
+			expect(reclaimer.handoffs() == 0_ul);
+			expect(nodesDestroyedElsewhere.load() == 0_l);
+		};
+
+		should("only one reclaimer is active") = [] {
+			go::background_reclaimer first(100);
+			{
+				go::background_reclaimer second(100);
+				expect(first.active());
+				expect(!second.active());
+			}
+
+			expect(first.active());
+		};
+
+		should("stopping the reclaimer destroys handed over errors") = [] {
+			{
+				go::background_reclaimer reclaimer(10);
+				for (int i = 0; i < 10; i++)
+					make_chain(1000);
+			}
+
+			expect(aliveNodes.load() == 0_l);
+
+			// Without a reclaimer everything is destroyed on the releasing thread
+			nodesDestroyedElsewhere = 0;
+			make_chain(1000);
+			expect(aliveNodes.load() == 0_l);
+			expect(nodesDestroyedElsewhere.load() == 0_l);
+		};
+	};
+
+	return 0;
+}
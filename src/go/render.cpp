@@ -0,0 +1,218 @@
+#include <go/render.hpp>
+#include <go/memoize.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+namespace go
+{
+    namespace
+    {
+        // A composite error whose wrapped errors are being rendered
+        struct open_error
+        {
+            error err;
+            message_layout layout;
+            error single;
+            error_span children;
+            std::size_t size;
+            std::size_t next;
+            std::size_t depth;
+            bool afterPending;
+        };
+
+        // Returns the size of str cut to at most size bytes, without splitting a UTF-8 code point
+        auto cut_size(std::string const& str, std::size_t size) -> std::size_t
+        {
+            if (str.size() <= size)
+                return str.size();
+
+            while (size > 0 && (static_cast<unsigned char>(str[size]) & 0xC0) == 0x80)
+                size--;
+
+            return size;
+        }
+
+        class budget_writer
+        {
+        public:
+            budget_writer(std::size_t maxBytes, traversal_options const& options) :
+                maxBytes_(maxBytes), options_(options)
+            {}
+
+            auto render(error const& err) -> std::string
+            {
+                if (!err)
+                {
+                    write("<nil>");
+                    return finish();
+                }
+
+                open(err, 0);
+                while (!stack_.empty() && !exhausted_)
+                {
+                    auto& top = stack_.back();
+                    if (top.afterPending)
+                    {
+                        top.afterPending = false;
+                        if (!write(top.layout.after_each))
+                            break;
+                    }
+
+                    if (top.next == top.size)
+                    {
+                        if (!write(top.layout.suffix))
+                            break;
+
+                        stack_.pop_back();
+                        continue;
+                    }
+
+                    if (top.next != 0 && !write(top.layout.between))
+                        break;
+
+                    if (!write(top.layout.before_each))
+                        break;
+
+                    auto child = top.single ? top.single : top.children[top.next];
+                    auto depth = top.depth + 1;
+                    top.next++;
+                    top.afterPending = true;
+
+                    if (!top.single)
+                        listEntries_.push_back(out_.size());
+
+                    // top may be invalidated by open
+                    open(child, depth);
+                }
+
+                return finish();
+            }
+
+        private:
+            auto write(std::string_view str) -> bool
+            {
+                if (exhausted_)
+                    return false;
+
+                if (out_.size() + str.size() > maxBytes_)
+                {
+                    out_.append(str.substr(0, maxBytes_ - out_.size()));
+                    exhausted_ = true;
+                    return false;
+                }
+
+                out_ += str;
+                return true;
+            }
+
+            auto open(error const& err, std::size_t depth) -> void
+            {
+                if (!err)
+                {
+                    write("<nil>");
+                    return;
+                }
+
+                if (depth > options_.cycle_check_depth)
+                {
+                    if (!seen_)
+                        seen_ = std::make_unique<std::unordered_set<error_interface const*>>();
+
+                    // Like is_error, errors already visited are skipped
+                    if (!seen_->insert(err.operator->()).second)
+                        return;
+                }
+
+                if (++nodes_ > options_.max_nodes || depth > options_.max_depth)
+                {
+                    exhausted_ = true;
+                    return;
+                }
+
+                auto composite = dynamic_cast<composite_message_interface const*>(err.operator->());
+                if (!composite)
+                {
+                    if (auto memoized = dynamic_cast<memoized_message const*>(err.operator->()))
+                        write(memoized->message_view());
+                    else
+                        write(err.message());
+
+                    return;
+                }
+
+                open_error entry{err, composite->message_layout(), err.unwrap(), {}, 1, 0, depth, false};
+                if (!entry.single)
+                {
+                    entry.children = err.unwrap_span();
+                    entry.size = entry.children.size();
+                }
+
+                if (write(entry.layout.prefix))
+                    stack_.push_back(std::move(entry));
+                else if (!entry.single)
+                    unreached_ += entry.size;
+            }
+
+            auto finish() -> std::string
+            {
+                if (!exhausted_)
+                    return std::move(out_);
+
+                // Errors of lists that weren't reached, the one being rendered is already counted
+                auto more = unreached_;
+                for (auto& open : stack_)
+                {
+                    if (!open.single)
+                        more += open.size - open.next;
+                }
+
+                // Entries whose message starts past the cut aren't rendered either. Cutting
+                // more entries makes the summary longer, which may cut more, so this is
+                // repeated until the count settles.
+                std::string summary;
+                std::size_t size = out_.size();
+                for (std::size_t cutEntries = 0;;)
+                {
+                    summary = more + cutEntries ? "... and " + std::to_string(more + cutEntries) + " more" : "...";
+                    if (summary.size() > maxBytes_)
+                        summary.resize(maxBytes_);
+
+                    size = cut_size(out_, maxBytes_ - summary.size());
+
+                    auto firstCut = std::lower_bound(listEntries_.begin(), listEntries_.end(), size);
+                    auto count = static_cast<std::size_t>(listEntries_.end() - firstCut);
+                    if (count == cutEntries)
+                        break;
+
+                    cutEntries = count;
+                }
+
+                out_.resize(size);
+                out_ += summary;
+                return std::move(out_);
+            }
+
+            std::size_t maxBytes_;
+            traversal_options const& options_;
+            std::string out_;
+            std::vector<open_error> stack_;
+            std::unique_ptr<std::unordered_set<error_interface const*>> seen_;
+            std::size_t nodes_ = 0;
+            bool exhausted_ = false;
+
+            // Offsets where the messages of the list entries that were reached start
+            std::vector<std::size_t> listEntries_;
+
+            // Errors of lists whose prefix didn't fit
+            std::size_t unreached_ = 0;
+        };
+    }
+
+    auto render(error const& err, std::size_t max_bytes, traversal_options const& options) -> std::string
+    {
+        return budget_writer(max_bytes, options).render(err);
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <go/error.hpp>
+#include <go/wrap.hpp>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace go
+{
+    /*! \addtogroup core
+     * @{
+     */
+
+    /// Text that a composite message puts around the messages of the wrapped errors.
+    /*!
+     * The message is the prefix, then for every wrapped error `before_each`, its
+     * message and `after_each`, with `between` separating them, and then the suffix.
+     */
+    struct message_layout
+    {
+        /// Text before the wrapped errors.
+        std::string prefix;
+
+        /// Text before the message of every wrapped error.
+        std::string_view before_each;
+
+        /// Text between the messages of two wrapped errors, after `after_each`.
+        std::string_view between;
+
+        /// Text after the message of every wrapped error.
+        std::string_view after_each;
+
+        /// Text after the wrapped errors.
+        std::string_view suffix;
+    };
+
+    /// Implemented by error data whose message only arranges the messages of the
+    /// errors it wraps, so that `go::render` can stop in the middle of it.
+    /*!
+     * The wrapped errors are the ones returned by `unwrap`, or by `unwrap_span` if
+     * `unwrap` returns an empty error. The message returned by `message` must equal
+     * the one described by the layout.
+     */
+    struct composite_message_interface
+    {
+        /// Returns the text to put around the messages of the wrapped errors.
+        virtual auto message_layout() const -> go::message_layout = 0;
+
+        virtual ~composite_message_interface() noexcept = default;
+    };
+
+    /// Returns err's message, cut to at most max_bytes.
+    /*!
+     * Errors that implement `go::composite_message_interface`, like wrap frames and
+     * lists, are rendered piece by piece, and rendering stops as soon as max_bytes are
+     * written. The wrapped errors that weren't reached are counted without being
+     * rendered, so the cost is bounded by max_bytes no matter how large the tree is.
+     * Other errors are rendered with `message` and cut.
+     *
+     * A cut message ends with "... and N more", where N counts the wrapped errors
+     * of lists that weren't rendered at all, or with "..." if there are none. Errors
+     * whose message the summary itself cuts away are counted too. The whole result,
+     * summary included, fits into max_bytes. Messages are only cut
+     * between UTF-8 code points.
+     *
+     * ```
+     * logger.error(go::render(err, 4096));
+     * ```
+     *
+     * Rendering also stops at the limits of options.
+     */
+    auto render(error const& err, std::size_t max_bytes, traversal_options const& options = {}) -> std::string;
+
+    /*! @} */
+}
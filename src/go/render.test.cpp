@@ -0,0 +1,100 @@
+#include <go/render.hpp>
+#include <go/error_chain.hpp>
+#include <go/error_fields.hpp>
+#include <go/errorf.hpp>
+#include <go/multi_error.hpp>
+
+#include <boost/ut.hpp>
+using namespace boost::ut;
+
+#include <atomic>
+
+std::atomic<int> renders{0};
+
+struct error_counted_data : public go::error_interface
+{
+	std::string message() const override
+	{
+		renders++;
+		return "counted";
+	}
+};
+
+using error_counted = go::error_of<error_counted_data>;
+
+int main()
+{
+	"render"_test = [] {
+		should("match message when the budget suffices") = [] {
+			auto list = go::append_error(go::errorf("a"), go::wrap_error(go::errorf("b"), "context"));
+			auto err = go::wrap_error(
+				go::with_fields(go::join_errors(list, go::errorf("c")), go::field("key", 1)),
+				"outer");
+
+			expect(go::render(err, 4096) == err.message()) << "got" << go::render(err, 4096);
+			expect(go::render(go::error(), 4096) == "<nil>");
+		};
+
+		should("cut long messages to the budget") = [] {
+			auto err = go::wrap_error(go::errorf("connection reset by peer"), "calling service");
+
+			auto rendered = go::render(err, 20);
+			expect(rendered == "calling service: ...") << "got" << rendered;
+			expect(rendered.size() == 20_ul);
+		};
+
+		should("count errors of lists that weren't rendered") = [] {
+			renders = 0;
+
+			go::error err;
+			for (int i = 0; i < 50000; i++)
+				err = go::append_error(std::move(err), go::make_error<error_counted>());
+
+			auto rendered = go::render(err, 100);
+			expect(rendered.find("50000 errors occurred:\n\t* counted\n") == 0_ul) << "got" << rendered;
+			expect(rendered.size() == 100_ul);
+			expect(rendered.substr(rendered.size() - 18) == "... and 49994 more") << "got" << rendered;
+			expect(renders.load() < 20_i);
+		};
+
+		should("count errors of all open lists") = [] {
+			auto inner = go::append_error(go::errorf("a"), go::errorf("b"), go::errorf("c"));
+			auto err = go::join_errors(go::wrap_error(inner, "first"), go::errorf("second"), go::errorf("third"));
+
+			// a and b were reached, but the summary cuts them
+			auto rendered = go::render(err, 36);
+			expect(rendered == "first: 3 errors occurr... and 5 more") << "got" << rendered;
+		};
+
+		should("count errors of lists whose prefix didn't fit") = [] {
+			auto err = go::join_errors(go::errorf("x"), go::append_error(go::errorf("a"), go::errorf("b"), go::errorf("c")));
+
+			auto rendered = go::render(err, 20);
+			expect(rendered == "x\n3 er... and 3 more") << "got" << rendered;
+		};
+
+		should("not cut UTF-8 code points") = [] {
+			auto err = go::errorf("caf\xC3\xA9 au lait");
+
+			auto rendered = go::render(err, 7);
+			expect(rendered == "caf...") << "got" << rendered;
+		};
+
+		should("stop at traversal limits") = [] {
+			auto err = go::wrap_error(go::wrap_error(go::errorf("root"), "inner"), "outer");
+
+			go::traversal_options options;
+			options.max_depth = 1;
+			expect(go::render(err, 4096, options) == "outer: inner: ...") << "got" << go::render(err, 4096, options);
+		};
+
+		should("fit tiny budgets") = [] {
+			auto err = go::append_error(go::errorf("a"), go::errorf("b"));
+
+			expect(go::render(err, 0).empty());
+			expect(go::render(err, 2) == "..") << "got" << go::render(err, 2);
+		};
+	};
+
+	return 0;
+}
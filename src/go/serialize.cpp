@@ -0,0 +1,427 @@
+#include <go/serialize.hpp>
+#include <go/error_chain.hpp>
+#include <go/error_code.hpp>
+#include <go/error_string.hpp>
+#include <go/errorf.hpp>
+
+#include <future>
+#include <ios>
+#include <limits>
+#include <mutex>
+#include <shared_mutex>
+#include <typeindex>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace go
+{
+    namespace
+    {
+        constexpr char magic[4] = {'G', 'O', 'E', '1'};
+        constexpr std::size_t header_size = sizeof(magic) + 4;
+
+        // Type, flags, number of children, message and payload lengths
+        constexpr std::size_t min_node_size = 4 + 1 + 4 + 4 + 4;
+
+        constexpr std::uint8_t flag_multiple = 1;
+
+        struct codec
+        {
+            std::uint32_t type_id;
+            error_encoder encode;
+        };
+
+        struct registry
+        {
+            std::shared_mutex mutex;
+            std::unordered_map<std::type_index, codec> encoders;
+            std::unordered_map<std::uint32_t, error_decoder> decoders;
+            std::unordered_map<std::string, std::error_category const*> categories;
+            std::unordered_map<std::uint32_t, error> sentinels;
+            std::unordered_map<error_interface const*, std::uint32_t> sentinelIds;
+
+            registry()
+            {
+                for (auto category : {&std::generic_category(), &std::system_category(),
+                    &std::iostream_category(), &std::future_category()})
+                    categories.emplace(category->name(), category);
+            }
+
+            static auto get() -> registry&
+            {
+                static registry instance;
+                return instance;
+            }
+        };
+
+        auto put_u32(std::string& out, std::uint32_t value) -> void
+        {
+            char bytes[4] = {
+                static_cast<char>(value & 0xFF),
+                static_cast<char>((value >> 8) & 0xFF),
+                static_cast<char>((value >> 16) & 0xFF),
+                static_cast<char>((value >> 24) & 0xFF),
+            };
+
+            out.append(bytes, sizeof(bytes));
+        }
+
+        auto patch_u32(std::string& out, std::size_t pos, std::uint32_t value) -> void
+        {
+            for (std::size_t i = 0; i < 4; i++)
+                out[pos + i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+        }
+
+        auto put_bytes(std::string& out, std::string_view bytes) -> void
+        {
+            put_u32(out, static_cast<std::uint32_t>(bytes.size()));
+            out.append(bytes);
+        }
+
+        // Sequential reader over a buffer, which fails once the buffer runs out
+        struct reader
+        {
+            std::string_view buffer;
+            std::size_t pos = 0;
+
+            auto u8(std::uint8_t& value) -> bool
+            {
+                if (buffer.size() - pos < 1)
+                    return false;
+
+                value = static_cast<std::uint8_t>(buffer[pos++]);
+                return true;
+            }
+
+            auto u32(std::uint32_t& value) -> bool
+            {
+                if (buffer.size() - pos < 4)
+                    return false;
+
+                value = 0;
+                for (std::size_t i = 0; i < 4; i++)
+                    value |= std::uint32_t(static_cast<unsigned char>(buffer[pos + i])) << (8 * i);
+
+                pos += 4;
+                return true;
+            }
+
+            auto bytes(std::string_view& value) -> bool
+            {
+                std::uint32_t size;
+                if (!u32(size) || buffer.size() - pos < size)
+                    return false;
+
+                value = buffer.substr(pos, size);
+                pos += size;
+                return true;
+            }
+        };
+
+        struct record
+        {
+            std::uint32_t type_id;
+            std::uint8_t flags;
+            std::uint32_t children;
+            std::string_view message;
+            std::string_view payload;
+        };
+
+        auto decode_code(registry& reg, record const& rec, std::vector<error>& children,
+            std::shared_ptr<void const> const& owner) -> error
+        {
+            reader payload{rec.payload};
+
+            std::string_view name;
+            std::uint32_t value;
+            if (!payload.bytes(name) || !payload.u32(value))
+                return {};
+
+            auto found = reg.categories.find(std::string(name));
+            if (found == reg.categories.end() || !children.empty())
+            {
+                return make_error<decoded_error>(rec.type_id, rec.message,
+                    std::move(children), (rec.flags & flag_multiple) != 0, owner);
+            }
+
+            return make_error<error_code>(std::error_code(static_cast<int>(value), *found->second));
+        }
+    }
+
+    auto register_error_codec(std::uint32_t type_id, std::type_info const& data_type,
+        error_encoder encode, error_decoder decode) -> error
+    {
+        if (type_id < wire_type::first_user)
+            return errorf("go::register_error_codec: type ID ", type_id, " is reserved");
+
+        auto& reg = registry::get();
+        std::unique_lock<std::shared_mutex> lock(reg.mutex);
+
+        if (!reg.encoders.emplace(std::type_index(data_type), codec{type_id, std::move(encode)}).second)
+            return errorf("go::register_error_codec: type ", data_type.name(), " already has a codec");
+
+        // Types registered under the same ID share the first decoder
+        reg.decoders.emplace(type_id, std::move(decode));
+        return {};
+    }
+
+    auto register_error_category(std::error_category const& category) -> void
+    {
+        auto& reg = registry::get();
+        std::unique_lock<std::shared_mutex> lock(reg.mutex);
+
+        reg.categories[category.name()] = &category;
+    }
+
+    auto register_sentinel(std::uint32_t id, error sentinel) -> error
+    {
+        auto& reg = registry::get();
+        std::unique_lock<std::shared_mutex> lock(reg.mutex);
+
+        if (reg.sentinels.count(id) != 0 || reg.sentinelIds.count(sentinel.data().get()) != 0)
+            return errorf("go::register_sentinel: sentinel ", id, " is already registered");
+
+        reg.sentinelIds.emplace(sentinel.data().get(), id);
+        reg.sentinels.emplace(id, std::move(sentinel));
+        return {};
+    }
+
+    auto encode_error(error const& err, std::string& out, traversal_options const& options) -> error
+    {
+        auto& reg = registry::get();
+        std::shared_lock<std::shared_mutex> lock(reg.mutex);
+
+        auto start = out.size();
+        out.append(magic, sizeof(magic));
+        put_u32(out, 0);
+
+        struct pending
+        {
+            error err;
+            std::size_t depth;
+        };
+
+        std::vector<pending> stack;
+        if (err)
+            stack.push_back({err, 0});
+
+        // Errors past cycle_check_depth on the path from the root to the current one. Errors
+        // shared by several parents are encoded once per parent, only an error that wraps
+        // itself is a cycle
+        std::vector<error_interface const*> path;
+        std::unordered_set<error_interface const*> onPath;
+
+        auto exceeded = [&]
+        {
+            out.resize(start);
+            return errorf("go::encode_error: error tree exceeds traversal limits");
+        };
+
+        std::size_t count = 0;
+        error single;
+        while (!stack.empty())
+        {
+            auto current = std::move(stack.back());
+            stack.pop_back();
+
+            if (count == options.max_nodes || current.depth > options.max_depth
+                || count == std::numeric_limits<std::uint32_t>::max())
+                return exceeded();
+
+            count++;
+
+            auto data = current.err.operator->();
+
+            // In preorder the errors visited last at lower depths are the ancestors
+            if (current.depth >= options.cycle_check_depth)
+            {
+                auto ancestors = current.depth - options.cycle_check_depth;
+                for (; path.size() > ancestors; path.pop_back())
+                    onPath.erase(path.back());
+
+                if (!onPath.insert(data).second)
+                    return exceeded();
+
+                path.push_back(data);
+            }
+
+            std::uint32_t typeId = wire_type::opaque;
+            std::string message;
+            error_span children;
+            std::uint8_t flags = 0;
+
+            std::string payload;
+
+            auto sentinel = reg.sentinelIds.find(data);
+            if (sentinel != reg.sentinelIds.end())
+            {
+                typeId = wire_type::sentinel;
+                put_u32(payload, sentinel->second);
+            }
+            else
+            {
+                if (auto child = current.err.unwrap())
+                {
+                    single = std::move(child);
+                    children = error_span(&single, 1);
+                }
+                else
+                {
+                    children = current.err.unwrap_span();
+                    if (!children.empty())
+                        flags |= flag_multiple;
+                }
+
+                auto custom = reg.encoders.find(std::type_index(typeid(*data)));
+                if (custom != reg.encoders.end())
+                {
+                    typeId = custom->second.type_id;
+                    message = current.err.message();
+                    custom->second.encode(current.err, payload);
+                }
+                else if (typeid(*data) == typeid(error_frame_data))
+                {
+                    // Messages of frames are derived from their context
+                    typeId = wire_type::frame;
+                    payload = static_cast<error_frame_data const*>(data)->context();
+                }
+                else if (auto code = dynamic_cast<error_code_data const*>(data))
+                {
+                    typeId = wire_type::code;
+                    message = current.err.message();
+                    put_bytes(payload, code->code().category().name());
+                    put_u32(payload, static_cast<std::uint32_t>(code->value()));
+                }
+                else
+                {
+                    typeId = dynamic_cast<error_string_data const*>(data) ? wire_type::string : wire_type::opaque;
+                    message = current.err.message();
+                }
+            }
+
+            put_u32(out, typeId);
+            out.push_back(static_cast<char>(flags));
+            put_u32(out, static_cast<std::uint32_t>(children.size()));
+            put_bytes(out, message);
+            put_bytes(out, payload);
+
+            for (auto i = children.size(); i-- > 0;)
+                stack.push_back({children[i], current.depth + 1});
+        }
+
+        patch_u32(out, start + sizeof(magic), static_cast<std::uint32_t>(count));
+        return {};
+    }
+
+    auto decode_error(std::string_view buffer, std::shared_ptr<void const> owner) -> std::pair<error, error>
+    {
+        if (buffer.size() < header_size || buffer.substr(0, sizeof(magic)) != std::string_view(magic, sizeof(magic)))
+            return {{}, errorf("go::decode_error: not an encoded error")};
+
+        reader in{buffer, sizeof(magic)};
+
+        std::uint32_t count;
+        in.u32(count);
+
+        if (count == 0)
+            return {};
+
+        // Rejects bogus counts before allocating for them
+        if (count > (buffer.size() - header_size) / min_node_size)
+            return {{}, errorf("go::decode_error: truncated buffer")};
+
+        std::vector<record> records(count);
+        for (auto& rec : records)
+        {
+            if (!in.u32(rec.type_id) || !in.u8(rec.flags) || !in.u32(rec.children)
+                || !in.bytes(rec.message) || !in.bytes(rec.payload))
+                return {{}, errorf("go::decode_error: truncated buffer")};
+        }
+
+        if (in.pos != buffer.size())
+            return {{}, errorf("go::decode_error: trailing bytes after the encoded error")};
+
+        auto& reg = registry::get();
+        std::shared_lock<std::shared_mutex> lock(reg.mutex);
+
+        // Errors are written in preorder, so building them in reverse order
+        // finds the children of each error on top of the stack
+        std::vector<error> stack;
+        std::vector<error> children;
+        for (auto rec = records.rbegin(); rec != records.rend(); ++rec)
+        {
+            if (rec->children > stack.size())
+                return {{}, errorf("go::decode_error: malformed error tree")};
+
+            children.clear();
+            for (std::uint32_t i = 0; i < rec->children; i++)
+            {
+                children.push_back(std::move(stack.back()));
+                stack.pop_back();
+            }
+
+            bool multiple = (rec->flags & flag_multiple) != 0;
+
+            error decoded;
+            switch (rec->type_id)
+            {
+            case wire_type::string:
+                // Strings don't wrap errors, unless they are custom types deriving from error_string
+                if (children.empty())
+                {
+                    decoded = make_error<error_string>(std::string(rec->message));
+                    break;
+                }
+
+                decoded = make_error<decoded_error>(rec->type_id, rec->message, std::move(children), multiple, owner);
+                break;
+
+            case wire_type::opaque:
+                decoded = make_error<decoded_error>(rec->type_id, rec->message, std::move(children), multiple, owner);
+                break;
+
+            case wire_type::code:
+                decoded = decode_code(reg, *rec, children, owner);
+                break;
+
+            case wire_type::sentinel:
+            {
+                reader payload{rec->payload};
+                std::uint32_t id;
+                auto found = payload.u32(id) ? reg.sentinels.find(id) : reg.sentinels.end();
+                if (found == reg.sentinels.end())
+                    return {{}, errorf("go::decode_error: unknown sentinel")};
+
+                decoded = found->second;
+                break;
+            }
+
+            case wire_type::frame:
+                if (children.size() == 1)
+                    decoded = wrap_error(std::move(children.front()), std::string(rec->payload));
+                break;
+
+            default:
+            {
+                auto custom = reg.decoders.find(rec->type_id);
+                if (custom != reg.decoders.end())
+                    decoded = custom->second(rec->payload, rec->message, std::move(children), owner);
+                else
+                    decoded = make_error<decoded_error>(rec->type_id, rec->message, std::move(children), multiple, owner);
+
+                break;
+            }
+            }
+
+            if (!decoded)
+                return {{}, errorf("go::decode_error: failed to decode error of type ", rec->type_id)};
+
+            stack.push_back(std::move(decoded));
+        }
+
+        if (stack.size() != 1)
+            return {{}, errorf("go::decode_error: malformed error tree")};
+
+        return {std::move(stack.front()), {}};
+    }
+}
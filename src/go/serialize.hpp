@@ -0,0 +1,197 @@
+#pragma once
+
+#include <go/error.hpp>
+#include <go/stack_trace.hpp>
+#include <go/source_location.hpp>
+#include <go/wrap.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace go
+{
+    /*! \addtogroup serialization Serialization
+     * @{
+     */
+
+    /// Stable type IDs of the wire format.
+    /*!
+     * IDs below `wire_type::first_user` are reserved by the library.
+     */
+    namespace wire_type
+    {
+        /// Error of a type without a codec. Only its message and structure are kept.
+        inline constexpr std::uint32_t opaque = 0;
+
+        /// `go::error_string`.
+        inline constexpr std::uint32_t string = 1;
+
+        /// `go::error_code`, with its category name and value.
+        inline constexpr std::uint32_t code = 2;
+
+        /// An error registered with `go::register_sentinel`.
+        inline constexpr std::uint32_t sentinel = 3;
+
+        /// A frame created by `go::wrap_error`.
+        inline constexpr std::uint32_t frame = 4;
+
+        /// The first ID available for custom codecs.
+        inline constexpr std::uint32_t first_user = 1024;
+    }
+
+    /// Error data of errors decoded without a codec of their own.
+    /*!
+     * The message is a view into the decoded buffer, so the buffer must outlive
+     * the error. `go::decode_error` can keep the buffer alive on its own.
+     */
+    struct decoded_error_data : public error_interface
+    {
+        /// Initialized with the decoded parts. When multiple is false,
+        /// children has at most one error, which is returned by unwrap.
+        decoded_error_data(std::uint32_t type_id, std::string_view message,
+            std::vector<error> children, bool multiple, std::shared_ptr<void const> buffer) :
+            type_id_(type_id), message_(message), children_(std::move(children)),
+            multiple_(multiple), buffer_(std::move(buffer))
+        {}
+
+        /// Returns the wire type ID of the encoded error.
+        auto type_id() const noexcept -> std::uint32_t
+        {
+            return type_id_;
+        }
+
+        /// Returns the message without copying it out of the buffer.
+        auto message_view() const noexcept -> std::string_view
+        {
+            return message_;
+        }
+
+        /// Returns a copy of the encoded message.
+        auto message() const -> std::string override
+        {
+            return std::string(message_);
+        }
+
+        /// Returns the decoded child, if the encoded error had one wrapped error.
+        auto unwrap() const -> error override
+        {
+            if (multiple_ || children_.empty())
+                return {};
+
+            return children_.front();
+        }
+
+        /// Returns the decoded children, if the encoded error wrapped multiple errors.
+        auto unwrap_multiple() const -> std::vector<error> const& override
+        {
+            if (!multiple_)
+                return error_interface::unwrap_multiple();
+
+            return children_;
+        }
+
+    private:
+        std::uint32_t type_id_;
+        std::string_view message_;
+        std::vector<error> children_;
+        bool multiple_;
+        std::shared_ptr<void const> buffer_;
+    };
+
+    /// An error decoded by `go::decode_error` that had no codec for its type.
+    /*!
+     * Refer to `go::decoded_error_data` for behavior details.
+     */
+    using decoded_error = error_of<decoded_error_data>;
+
+    /// Appends the type specific payload of err to payload.
+    using error_encoder = std::function<void(error const& err, std::string& payload)>;
+
+    /// Creates an error out of its payload, message and already decoded children.
+    /*!
+     * The views point into the decoded buffer, which owner keeps alive, as passed to
+     * `go::decode_error`. Decoders that keep the views, instead of copying them, have to
+     * keep owner as well. Returning an empty error fails decoding.
+     */
+    using error_decoder = std::function<error(std::string_view payload, std::string_view message,
+        std::vector<error>&& children, std::shared_ptr<void const> const& owner)>;
+
+    /// Registers a codec for errors whose data is exactly of data_type.
+    /*!
+     * Codecs are expected to be registered at startup, before errors are encoded.
+     * Fails if type_id is reserved or data_type already has a codec. Types registered
+     * under the same ID share the decoder registered first.
+     *
+     * Codecs run under the registry lock, so they must not register anything.
+     */
+    auto register_error_codec(std::uint32_t type_id, std::type_info const& data_type,
+        error_encoder encode, error_decoder decode) -> error;
+
+    /// Registers a codec for ErrorType, including its traced and located variants.
+    template <class ErrorType>
+    auto register_error_codec(std::uint32_t type_id, error_encoder encode, error_decoder decode) -> error
+    {
+        using Impl = typename ErrorType::impl_type;
+
+        auto err = register_error_codec(type_id, typeid(Impl), encode, decode);
+        if constexpr (!std::is_final_v<Impl>)
+        {
+            if (!err)
+                err = register_error_codec(type_id, typeid(detail::traced_data<Impl>), encode, decode);
+            if (!err)
+                err = register_error_codec(type_id, typeid(detail::located_data<Impl>), encode, decode);
+        }
+
+        return err;
+    }
+
+    /// Makes `go::error_code` errors of category decode back into `go::error_code`.
+    /*!
+     * Categories are matched by name. The generic, system, iostream and future
+     * categories are registered by default. Codes of unknown categories are
+     * decoded as `go::decoded_error`.
+     */
+    auto register_error_category(std::error_category const& category) -> void;
+
+    /// Makes sentinel encode as its ID and decode back into the same error.
+    /*!
+     * This way `go::is_error` keeps working with sentinels across process boundaries,
+     * as long as both sides register the same IDs. Fails if id or sentinel is
+     * already registered.
+     */
+    auto register_sentinel(std::uint32_t id, error sentinel) -> error;
+
+    /// Appends the binary encoding of err's tree to out.
+    /*!
+     * The encoding starts with a header followed by the errors of the tree in
+     * preorder. Each error is written with its type ID, the number of its children,
+     * its message and a type specific payload, with integers in little endian.
+     *
+     * Errors shared by multiple parents are written once per parent. Trees with
+     * unwrap cycles fail to encode with the error of exceeded traversal limits: past
+     * options.cycle_check_depth, an error that wraps itself, directly or through other
+     * errors, is detected as soon as it is reached again.
+     */
+    auto encode_error(error const& err, std::string& out, traversal_options const& options = {}) -> error;
+
+    /// Decodes an error tree encoded with `go::encode_error`.
+    /*!
+     * `go::error_string` errors without wrapped errors decode back into `go::error_string`,
+     * with a copy of their message. Messages of `go::decoded_error` errors point into
+     * buffer instead of being copied. owner is kept alive by every such error and passed
+     * to custom decoders, so pass the owner of the buffer unless it's guaranteed to
+     * outlive the errors.
+     *
+     * Returns the decoded error, or an empty error and the reason decoding failed.
+     */
+    auto decode_error(std::string_view buffer, std::shared_ptr<void const> owner = {}) -> std::pair<error, error>;
+
+    /*! @} */
+}
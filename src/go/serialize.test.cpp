@@ -0,0 +1,231 @@
+#include <go/go_error.hpp>
+#include <go/serialize.hpp>
+
+#include <boost/ut.hpp>
+using namespace boost::ut;
+
+struct error_group_data : public go::error_interface
+{
+	error_group_data(std::vector<go::error> errs) :
+		errs_(std::move(errs))
+	{}
+
+	std::string message() const override { return "group"; }
+
+	std::vector<go::error> const& unwrap_multiple() const override { return errs_; }
+
+private:
+	std::vector<go::error> errs_;
+};
+
+using error_group = go::error_of<error_group_data>;
+
+struct error_port_data : public go::error_interface
+{
+	error_port_data(int port) : port(port) {}
+
+	std::string message() const override { return "port " + std::to_string(port) + " is busy"; }
+
+	int port;
+};
+
+using error_port = go::error_of<error_port_data>;
+
+struct error_note_data : public go::error_interface
+{
+	std::string message() const override { return "note"; }
+};
+
+using error_note = go::error_of<error_note_data>;
+
+// Error whose wrapped error can be made to point back at itself
+struct error_cycle_data : public go::error_interface
+{
+	go::error next;
+
+	std::string message() const override { return "cycle"; }
+	go::error unwrap() const override { return next; }
+};
+
+using error_cycle = go::error_of<error_cycle_data>;
+
+auto roundtrip(go::error const& err) -> go::error
+{
+	std::string buffer;
+	expect(!go::encode_error(err, buffer));
+
+	auto owner = std::make_shared<std::string const>(std::move(buffer));
+	auto [decoded, decodeErr] = go::decode_error(*owner, owner);
+	expect(!decodeErr) << decodeErr.message();
+
+	return decoded;
+}
+
+int main()
+{
+	static const auto errNotFound = go::make_error<go::error_string>("not found");
+	expect(!go::register_sentinel(1, errNotFound));
+
+	"encode_error"_test = [] {
+		should("messages survive") = [] {
+			auto err = go::wrap_error(go::errorf("disk ", 3, " failed"), "saving");
+			expect(roundtrip(err).message() == err.message());
+		};
+
+		should("messages are viewed in place") = [] {
+			std::string buffer;
+			go::encode_error(go::make_error<error_group>(std::vector<go::error>{}), buffer);
+
+			auto [decoded, err] = go::decode_error(buffer);
+			auto data = go::error_cast<go::decoded_error>(decoded);
+			expect(data == true);
+			expect(data.data()->message_view() == "group");
+			expect(data.data()->message_view().data() >= buffer.data());
+			expect(data.data()->message_view().data() < buffer.data() + buffer.size());
+			expect(data.data()->type_id() == go::wire_type::opaque);
+		};
+
+		should("strings decode into error_string") = [] {
+			auto decoded = roundtrip(go::wrap_error(go::errorf("disk ", 3, " failed"), "saving"));
+
+			go::error_string str;
+			expect(go::as_error(decoded, str));
+			expect(str.message() == "disk 3 failed");
+		};
+
+		should("sentinels keep their identity") = [] {
+			auto err = go::wrap_error(errNotFound, "reading config");
+			auto decoded = roundtrip(err);
+
+			expect(go::is_error(decoded, errNotFound));
+			expect(decoded.message() == "reading config: not found");
+		};
+
+		should("error codes decode into error_code") = [] {
+			auto ec = std::make_error_code(std::errc::timed_out);
+			auto decoded = roundtrip(go::make_error<go::error_code>(ec));
+
+			go::error_code code;
+			expect(go::as_error(decoded, code));
+			expect(code.data()->code() == ec);
+		};
+
+		should("multiple children keep their order") = [] {
+			auto err = go::make_error<error_group>(std::vector<go::error>{
+				go::make_error<go::error_string>("a"),
+				errNotFound,
+				go::make_error<go::error_string>("c"),
+			});
+
+			auto decoded = roundtrip(err);
+			expect(decoded.message() == "group");
+			expect(decoded.unwrap() == false);
+
+			auto& children = decoded.unwrap_multiple();
+			expect(children.size() == 3_ul);
+			expect(children[0].message() == "a");
+			expect(children[1] == errNotFound);
+			expect(children[2].message() == "c");
+		};
+
+		should("custom codecs restore their type") = [] {
+			auto regErr = go::register_error_codec<error_port>(go::wire_type::first_user,
+				[](go::error const& err, std::string& payload) {
+					payload = std::to_string(go::error_cast<error_port>(err).data()->port);
+				},
+				[](std::string_view payload, std::string_view, std::vector<go::error>&&, std::shared_ptr<void const> const&) -> go::error {
+					return go::make_error<error_port>(std::stoi(std::string(payload)));
+				});
+			expect(!regErr);
+
+			auto decoded = roundtrip(go::wrap_error(go::make_error<error_port>(8080), "listening"));
+
+			error_port port;
+			expect(go::as_error(decoded, port));
+			expect(port.data()->port == 8080_i);
+
+			expect(go::register_error_codec<error_port>(go::wire_type::first_user, nullptr, nullptr) == true)
+				<< "duplicate registration should fail";
+			expect(go::register_error_codec(go::wire_type::frame, typeid(error_group_data), nullptr, nullptr) == true)
+				<< "reserved IDs should fail";
+		};
+
+		should("custom decoders can keep the buffer alive") = [] {
+			auto regErr = go::register_error_codec<error_note>(go::wire_type::first_user + 1,
+				[](go::error const&, std::string&) {},
+				[](std::string_view, std::string_view message, std::vector<go::error>&&, std::shared_ptr<void const> const& owner) -> go::error {
+					return go::make_error<go::decoded_error>(go::wire_type::first_user + 1, message,
+						std::vector<go::error>{}, false, owner);
+				});
+			expect(!regErr);
+
+			go::error decoded;
+			{
+				std::string buffer;
+				go::encode_error(go::make_error<error_note>(), buffer);
+
+				auto owner = std::make_shared<std::string const>(std::move(buffer));
+				decoded = go::decode_error(*owner, owner).first;
+			}
+
+			expect(decoded.message() == "note");
+		};
+
+		should("cycles fail to encode") = [] {
+			auto cycle = go::make_error<error_cycle>();
+			cycle->next = go::wrap_error(cycle, "again");
+
+			std::string buffer = "kept";
+			auto err = go::encode_error(cycle, buffer);
+			expect(err == true);
+			expect(buffer == "kept");
+
+			cycle->next = {};
+		};
+
+		should("errors shared deep in the tree are not cycles") = [] {
+			auto shared = go::make_error<go::error_string>("shared");
+			go::error chain = go::make_error<error_group>(std::vector<go::error>{shared, shared});
+			for (int i = 0; i < 100; i++)
+				chain = go::wrap_error(chain, "frame");
+
+			auto decoded = roundtrip(go::make_error<error_group>(std::vector<go::error>{chain, chain}));
+			expect(decoded.unwrap_multiple().size() == 2_ul);
+		};
+
+		should("empty error encodes") = [] {
+			auto decoded = roundtrip({});
+			expect(decoded == false);
+		};
+	};
+
+	"decode_error"_test = [] {
+		std::string buffer;
+		go::encode_error(go::wrap_error(go::make_error<go::error_string>("x"), "y"), buffer);
+
+		should("reject truncated buffers") = [=] {
+			for (std::size_t size = 0; size < buffer.size(); size++)
+			{
+				auto [decoded, err] = go::decode_error(std::string_view(buffer).substr(0, size));
+				expect(err == true) << "size" << size;
+				expect(decoded == false);
+			}
+		};
+
+		should("reject garbage") = [=] {
+			auto corrupted = buffer;
+			corrupted[4] = '\x7F';
+
+			auto [decoded, err] = go::decode_error(corrupted);
+			expect(err == true);
+
+			std::string unknown;
+			go::encode_error(go::make_error<go::error_string>("x"), unknown);
+			unknown[8] = 3; // sentinel without an ID
+
+			expect(go::decode_error(unknown).second == true);
+		};
+	};
+
+	return 0;
+}
@@ -0,0 +1,250 @@
+#pragma once
+
+#include <go/error.hpp>
+#include <go/error_string.hpp>
+#include <go/errorf.hpp>
+#include <go/wrap.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+
+// The library and its users may be compiled with different language levels, so the
+// layout of go::source_location can't depend on the one of each translation unit.
+// GOERROR_STD_SOURCE_LOCATION is defined for the library and all of its users when
+// the library itself is built as C++20, refer to GOERROR_CXX_STANDARD.
+#if defined(GOERROR_STD_SOURCE_LOCATION)
+    #include <source_location>
+
+    #if !defined(__cpp_lib_source_location)
+        #error "GOERROR_STD_SOURCE_LOCATION requires std::source_location, compile with C++20"
+    #endif
+
+    #define GOERROR_HAS_STD_SOURCE_LOCATION 1
+#else
+    #define GOERROR_HAS_STD_SOURCE_LOCATION 0
+#endif
+
+namespace go
+{
+    /*! \addtogroup tracing
+     * @{
+     */
+
+    /// File, line and function of a place in the source code.
+    /*!
+     * When the library is built as C++20, this is a thin wrapper around `std::source_location`,
+     * which on the major standard libraries is a single pointer to static data generated
+     * by the compiler. Otherwise the compiler builtins are used instead, storing the pointers
+     * to the static file and function name strings and the line number. The choice is made
+     * by the library's build, not by the language level of code that includes this header.
+     *
+     * In both cases no strings are copied.
+     */
+    struct source_location
+    {
+#if GOERROR_HAS_STD_SOURCE_LOCATION
+        /// Returns the location of the call site.
+        static constexpr auto current(std::source_location loc = std::source_location::current()) noexcept -> source_location
+        {
+            source_location result;
+            result.loc_ = loc;
+            return result;
+        }
+
+        /// Name of the source file.
+        constexpr auto file_name() const noexcept -> const char* { return loc_.file_name(); }
+
+        /// Name of the enclosing function.
+        constexpr auto function_name() const noexcept -> const char* { return loc_.function_name(); }
+
+        /// Line number, starting with 1.
+        constexpr auto line() const noexcept -> std::uint_least32_t { return loc_.line(); }
+
+    private:
+        std::source_location loc_;
+#else
+        /// Returns the location of the call site.
+        static constexpr auto current(
+            const char* file = __builtin_FILE(),
+            const char* function = __builtin_FUNCTION(),
+            std::uint_least32_t line = __builtin_LINE()) noexcept -> source_location
+        {
+            source_location result;
+            result.file_ = file;
+            result.function_ = function;
+            result.line_ = line;
+            return result;
+        }
+
+        /// Name of the source file.
+        constexpr auto file_name() const noexcept -> const char* { return file_; }
+
+        /// Name of the enclosing function.
+        constexpr auto function_name() const noexcept -> const char* { return function_; }
+
+        /// Line number, starting with 1.
+        constexpr auto line() const noexcept -> std::uint_least32_t { return line_; }
+
+    private:
+        const char* file_ = "";
+        const char* function_ = "";
+        std::uint_least32_t line_ = 0;
+#endif
+    };
+
+    /// Implemented by errors that recorded where they were created.
+    struct source_location_interface
+    {
+        /// Returns the location passed to `go::make_error_at` or `go::errorf_at`.
+        virtual auto location() const -> source_location const& = 0;
+
+        virtual ~source_location_interface() noexcept = default;
+    };
+
+    /// The text that starts the arguments of `go::errorf_at`, together with the location
+    /// of the call.
+    /*!
+     * Created implicitly from strings, so that the location is recorded without being
+     * passed explicitly. The text is only viewed.
+     */
+    struct format_site
+    {
+        /// Views text and records loc, which defaults to the location of the call.
+        template <class S, class = std::enable_if_t<std::is_convertible_v<S const&, std::string_view>>>
+        format_site(S const& text, source_location loc = source_location::current()) noexcept :
+            text(text), location(loc)
+        {}
+
+        /// The first text of the message.
+        std::string_view text;
+
+        /// Where the error is created.
+        source_location location;
+    };
+
+    /*! @} */
+
+    /// \cond TEMPLATE_DETAILS
+    namespace detail
+    {
+        /// Error data that extends Impl with the location of its creation.
+        template <class Impl>
+        struct located_data final : public Impl, public source_location_interface
+        {
+            template <class... Args>
+            located_data(source_location const& loc, Args&&... args) :
+                Impl(std::forward<Args>(args)...), loc_(loc)
+            {}
+
+            auto location() const -> source_location const& override
+            {
+                return loc_;
+            }
+
+        private:
+            source_location loc_;
+        };
+
+        template <class ErrorType>
+        struct make_error_at_impl
+        {
+            static_assert(always_false<ErrorType>::value, "ErrorType should a valid go::error_of<T>");
+        };
+
+        template <class Impl>
+        struct make_error_at_impl<error_of<Impl>>
+        {
+            static_assert(!std::is_final_v<Impl>, "located errors extend the error data, which can't be final");
+
+            template <class... Args>
+            static auto make(source_location const& loc, Args&&... args) -> error_of<Impl>
+            {
+                auto impl = std::make_shared<located_data<Impl>>(loc, std::forward<Args>(args)...);
+                on_error_created<Impl>(impl);
+                return error_of<Impl>(std::move(impl));
+            }
+        };
+    } // namespace detail
+    /// \endcond
+
+    /*! \addtogroup tracing
+     * @{
+     */
+
+    /// Like `go::make_error`, but records loc inside the created error.
+    /*!
+     * Pass `go::source_location::current()` to record the call site:
+     *
+     * ```
+     * return go::make_error_at<error_parse>(go::source_location::current(), line);
+     * ```
+     *
+     * The location shares the allocation of the error data, so recording it costs
+     * a store of the location value. It can be retrieved with `go::find_source_location`
+     * or by looking for `go::source_location_interface` with `go::as_error`.
+     *
+     * The location has to be passed explicitly, because a defaulted argument can't
+     * follow the constructor arguments pack. `go::errorf_at` records it implicitly.
+     */
+    template <class ErrorType, class... Args>
+    auto make_error_at(source_location const& loc, Args&&... args) -> ErrorType
+    {
+        return detail::make_error_at_impl<ErrorType>::make(loc, std::forward<Args>(args)...);
+    }
+
+    /// Like `go::errorf`, but records loc inside the created error.
+    template <class... Ts>
+    auto errorf_at(source_location const& loc, Ts&&... args) -> go::error
+    {
+        std::stringstream stream;
+        (stream << ... << std::forward<Ts>(args));
+
+        return make_error_at<go::error_string>(loc, stream.str());
+    }
+
+    /// Like `go::errorf`, but records the location of the call inside the created error.
+    /*!
+     * The first argument has to be a string, which records the location on its way
+     * to `go::format_site`:
+     *
+     * ```
+     * return go::errorf_at("bad line ", line);
+     * ```
+     */
+    template <class... Ts>
+    auto errorf_at(format_site first, Ts&&... args) -> go::error
+    {
+        std::stringstream stream;
+        (stream << first.text << ... << std::forward<Ts>(args));
+
+        return make_error_at<go::error_string>(first.location, stream.str());
+    }
+
+    /// Returns the location of the first error in err's tree that recorded one,
+    /// or nothing if there is none.
+    /*!
+     * The location is returned by value, so it stays valid after the errors are gone:
+     *
+     * ```
+     * auto loc = go::find_source_location(go::errorf_at("boom"));
+     * ```
+     */
+    inline auto find_source_location(error const& err) -> std::optional<source_location>
+    {
+        std::optional<source_location> found;
+
+        detail::wrapping_impl::walk(err, traversal_options{}, [&](error const& node)
+        {
+            if (auto located = dynamic_cast<source_location_interface const*>(node.operator->()))
+                found = located->location();
+
+            return found.has_value();
+        });
+
+        return found;
+    }
+
+    /*! @} */
+}
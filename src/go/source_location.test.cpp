@@ -0,0 +1,111 @@
+#include <go/source_location.hpp>
+#include <go/error_chain.hpp>
+
+#include <boost/ut.hpp>
+using namespace boost::ut;
+
+#include <string_view>
+
+struct error_located_data : public go::error_interface
+{
+	int value;
+
+	explicit error_located_data(int value) : value(value) {}
+
+	std::string message() const override { return "located " + std::to_string(value); }
+};
+
+using error_located = go::error_of<error_located_data>;
+
+auto ends_with(std::string_view str, std::string_view suffix) -> bool
+{
+	return str.size() >= suffix.size() && str.substr(str.size() - suffix.size()) == suffix;
+}
+
+int main()
+{
+	"source_location"_test = [] {
+		should("current returns the location of the call site") = [] {
+			auto line = __LINE__; auto loc = go::source_location::current();
+
+			expect(loc.line() == static_cast<std::uint_least32_t>(line)) << "got" << loc.line() << "want" << line;
+			expect(ends_with(loc.file_name(), "source_location.test.cpp")) << "got" << loc.file_name();
+			expect(loc.function_name() != nullptr);
+		};
+
+#if GOERROR_HAS_STD_SOURCE_LOCATION && defined(__GLIBCXX__)
+		should("location is a single pointer") = [] {
+			expect(sizeof(go::source_location) == sizeof(void*));
+		};
+#endif
+	};
+
+	"make_error_at"_test = [] {
+		should("error behaves as the requested error type") = [] {
+			auto err = go::make_error_at<error_located>(go::source_location::current(), 7);
+
+			expect(err->value == 7);
+			expect(err.message() == "located 7") << "got" << err.message();
+		};
+
+		should("location can be found through wrapping errors") = [] {
+			auto line = __LINE__; go::error err = go::make_error_at<error_located>(go::source_location::current(), 1);
+			err = go::wrap_error(std::move(err), "context");
+
+			auto loc = go::find_source_location(err);
+			expect(loc.has_value());
+			if (loc)
+				expect(loc->line() == static_cast<std::uint_least32_t>(line)) << "got" << loc->line() << "want" << line;
+
+			go::source_location_interface* located = nullptr;
+			expect(go::as_error(err, located));
+		};
+
+		should("plain errors don't have a location") = [] {
+			expect(go::find_source_location(go::make_error<error_located>(1)).has_value() == false);
+		};
+	};
+
+	"errorf_at"_test = [] {
+		should("message is formatted as with errorf") = [] {
+			auto line = __LINE__; auto err = go::errorf_at(go::source_location::current(), "value: ", 42);
+
+			expect(err.message() == "value: 42") << "got" << err.message();
+			expect(go::error_cast<go::error_string>(err) == true);
+
+			auto loc = go::find_source_location(err);
+			expect(loc.has_value());
+			if (loc)
+			{
+				expect(loc->line() == static_cast<std::uint_least32_t>(line));
+				expect(ends_with(loc->file_name(), "source_location.test.cpp")) << "got" << loc->file_name();
+			}
+		};
+
+		should("location is recorded implicitly") = [] {
+			auto line = __LINE__; auto err = go::errorf_at("value: ", 42, " of ", std::string("many"));
+
+			expect(err.message() == "value: 42 of many") << "got" << err.message();
+
+			auto loc = go::find_source_location(err);
+			expect(loc.has_value());
+			if (loc)
+			{
+				expect(loc->line() == static_cast<std::uint_least32_t>(line)) << "got" << loc->line() << "want" << line;
+				expect(ends_with(loc->file_name(), "source_location.test.cpp")) << "got" << loc->file_name();
+			}
+
+			expect(go::errorf_at(std::string("only text")).message() == "only text");
+		};
+
+		should("location outlives the error it was found in") = [] {
+			auto line = __LINE__; auto loc = go::find_source_location(go::errorf_at("boom"));
+
+			expect(loc.has_value());
+			if (loc)
+				expect(loc->line() == static_cast<std::uint_least32_t>(line)) << "got" << loc->line() << "want" << line;
+		};
+	};
+
+	return 0;
+}
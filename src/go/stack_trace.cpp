@@ -0,0 +1,122 @@
+#include <go/stack_trace.hpp>
+#include <go/detail/demangle.hpp>
+
+#include <algorithm>
+#include <sstream>
+
+#if defined(_WIN32)
+    #define NOMINMAX
+    #include <windows.h>
+    #include <dbghelp.h>
+    #include <mutex>
+#elif defined(__has_include)
+    #if __has_include(<execinfo.h>) && __has_include(<dlfcn.h>)
+        #include <execinfo.h>
+        #include <dlfcn.h>
+        #define GOERROR_HAS_EXECINFO
+    #endif
+#endif
+
+namespace go
+{
+    namespace
+    {
+#if defined(_WIN32)
+        // DbgHelp is single-threaded
+        std::mutex symbolsMutex;
+
+        auto init_symbols() -> HANDLE
+        {
+            static HANDLE process = [] {
+                HANDLE self = GetCurrentProcess();
+                SymSetOptions(SYMOPT_UNDNAME | SYMOPT_DEFERRED_LOADS | SYMOPT_LOAD_LINES);
+                SymInitialize(self, nullptr, TRUE);
+                return self;
+            }();
+
+            return process;
+        }
+#endif
+
+        auto describe_frame(void* address) -> std::string
+        {
+            std::stringstream ss;
+            ss << address;
+
+#if defined(_WIN32)
+            std::lock_guard<std::mutex> lock(symbolsMutex);
+            HANDLE process = init_symbols();
+
+            alignas(SYMBOL_INFO) char buffer[sizeof(SYMBOL_INFO) + MAX_SYM_NAME];
+            auto symbol = reinterpret_cast<SYMBOL_INFO*>(buffer);
+            symbol->SizeOfStruct = sizeof(SYMBOL_INFO);
+            symbol->MaxNameLen = MAX_SYM_NAME;
+
+            DWORD64 displacement = 0;
+            if (SymFromAddr(process, reinterpret_cast<DWORD64>(address), &displacement, symbol))
+                ss << " " << symbol->Name << "+0x" << std::hex << displacement << std::dec;
+
+            IMAGEHLP_LINE64 line{};
+            line.SizeOfStruct = sizeof(line);
+            DWORD lineDisplacement = 0;
+            if (SymGetLineFromAddr64(process, reinterpret_cast<DWORD64>(address), &lineDisplacement, &line))
+                ss << " at " << line.FileName << ":" << line.LineNumber;
+#elif defined(GOERROR_HAS_EXECINFO)
+            Dl_info info{};
+            if (dladdr(address, &info))
+            {
+                if (info.dli_sname)
+                {
+                    auto offset = static_cast<char*>(address) - static_cast<char*>(info.dli_saddr);
+                    ss << " " << detail::demangle(info.dli_sname) << "+0x" << std::hex << offset << std::dec;
+                }
+
+                if (info.dli_fname)
+                {
+                    auto offset = static_cast<char*>(address) - static_cast<char*>(info.dli_fbase);
+                    ss << " in " << info.dli_fname << "+0x" << std::hex << offset << std::dec;
+                }
+            }
+#endif
+
+            return ss.str();
+        }
+    }
+
+    auto stack_trace::capture(std::size_t skip) noexcept -> stack_trace
+    {
+        stack_trace trace;
+
+        // Skip the capture function itself too
+        skip += 1;
+
+#if defined(_WIN32)
+        trace.size = RtlCaptureStackBackTrace(
+            static_cast<DWORD>(skip), static_cast<DWORD>(max_frames), trace.frames.data(), nullptr);
+#elif defined(GOERROR_HAS_EXECINFO)
+        std::array<void*, max_frames + 8> raw;
+        auto count = static_cast<std::size_t>(backtrace(raw.data(), static_cast<int>(raw.size())));
+        if (count > skip)
+        {
+            trace.size = std::min(count - skip, max_frames);
+            std::copy(raw.begin() + skip, raw.begin() + skip + trace.size, trace.frames.begin());
+        }
+#else
+        (void)skip;
+#endif
+
+        return trace;
+    }
+
+    auto stack_trace::to_string() const -> std::string
+    {
+        std::string result;
+
+        for (std::size_t i = 0; i < size; i++)
+        {
+            result += "#" + std::to_string(i) + " " + describe_frame(frames[i]) + "\n";
+        }
+
+        return result;
+    }
+}
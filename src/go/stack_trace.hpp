@@ -0,0 +1,206 @@
+#pragma once
+
+#include <go/error.hpp>
+#include <go/wrap.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace go
+{
+    /*! \addtogroup tracing Tracing
+     * @{
+     */
+
+    /// Raw return addresses of a call stack.
+    /*!
+     * Capturing only walks the stack and stores addresses into an inline array, without
+     * allocating. Addresses are resolved to symbols only when the trace is printed with
+     * `to_string`, which is considerably more expensive.
+     */
+    struct stack_trace
+    {
+        /// Maximum number of frames kept. Deeper frames are dropped.
+        static constexpr std::size_t max_frames = 32;
+
+        /// Return addresses, innermost first.
+        std::array<void*, max_frames> frames{};
+
+        /// Number of valid entries in `frames`.
+        std::size_t size = 0;
+
+        /// Captures the call stack of the caller, skipping skip innermost frames.
+        static auto capture(std::size_t skip = 0) noexcept -> stack_trace;
+
+        /// True if no frames were captured.
+        auto empty() const noexcept -> bool
+        {
+            return size == 0;
+        }
+
+        /// Begin iterator over captured frames.
+        auto begin() const noexcept -> void* const*
+        {
+            return frames.data();
+        }
+
+        /// End iterator over captured frames.
+        auto end() const noexcept -> void* const*
+        {
+            return frames.data() + size;
+        }
+
+        /// Resolves frames to symbol names and formats them, one frame per line.
+        /*!
+         * Symbol names are only available when the binary exports them, for example when
+         * linked with `-rdynamic` on Linux, or when PDB files are available on Windows.
+         * Otherwise, only module names and offsets are printed.
+         */
+        auto to_string() const -> std::string;
+    };
+
+    /// Implemented by errors that recorded a stack trace at creation.
+    struct stack_trace_interface
+    {
+        /// Returns the stack trace captured when the error was created. May be empty
+        /// if the capture was skipped by a `go::trace_sampler`.
+        virtual auto trace() const -> stack_trace const& = 0;
+
+        virtual ~stack_trace_interface() noexcept = default;
+    };
+
+    /// Decides how often a call site captures stack traces.
+    /*!
+     * Intended to be declared as a static variable next to a `go::make_traced_error` call,
+     * so that each call site has its own rate:
+     *
+     * ```
+     * static go::trace_sampler site(100);
+     * return go::make_traced_error<error_parse>(site, line);
+     * ```
+     */
+    class trace_sampler
+    {
+    public:
+        /// Captures a trace for one in every_n errors. Zero disables capturing.
+        explicit trace_sampler(std::uint32_t every_n = 1) noexcept :
+            every_n_(every_n)
+        {}
+
+        /// Returns true if the current error should capture a trace. Thread-safe.
+        auto sample() noexcept -> bool
+        {
+            if (every_n_ == 0)
+                return false;
+
+            return counter_.fetch_add(1, std::memory_order_relaxed) % every_n_ == 0;
+        }
+
+    private:
+        std::uint32_t every_n_;
+        std::atomic<std::uint32_t> counter_{0};
+    };
+
+    /*! @} */
+
+    /// \cond TEMPLATE_DETAILS
+    namespace detail
+    {
+        /// Error data that extends Impl with an inline stack trace, so that the trace
+        /// shares the allocation of the error.
+        template <class Impl>
+        struct traced_data final : public Impl, public stack_trace_interface
+        {
+            template <class... Args>
+            traced_data(stack_trace const& trace, Args&&... args) :
+                Impl(std::forward<Args>(args)...), trace_(trace)
+            {}
+
+            auto trace() const -> stack_trace const& override
+            {
+                return trace_;
+            }
+
+        private:
+            stack_trace trace_;
+        };
+
+        template <class ErrorType>
+        struct make_traced_error_impl
+        {
+            static_assert(always_false<ErrorType>::value, "ErrorType should a valid go::error_of<T>");
+        };
+
+        template <class Impl>
+        struct make_traced_error_impl<error_of<Impl>>
+        {
+            static_assert(!std::is_final_v<Impl>, "traced errors extend the error data, which can't be final");
+
+            template <class... Args>
+            static auto make(bool capture, Args&&... args) -> error_of<Impl>
+            {
+                auto trace = capture ? stack_trace::capture(1) : stack_trace{};
+                auto impl = std::make_shared<traced_data<Impl>>(trace, std::forward<Args>(args)...);
+                on_error_created<Impl>(impl);
+                return error_of<Impl>(std::move(impl));
+            }
+        };
+    } // namespace detail
+    /// \endcond
+
+    /*! \addtogroup tracing
+     * @{
+     */
+
+    /// Like `go::make_error`, but records the call stack inside the created error.
+    /*!
+     * The trace is kept inline in the error data, so it costs one stack walk and no
+     * additional allocation. It can be retrieved with `go::find_stack_trace` or by
+     * looking for `go::stack_trace_interface` with `go::as_error`.
+     *
+     * The innermost frames of the trace may belong to this function.
+     */
+    template <class ErrorType, class... Args>
+    auto make_traced_error(Args&&... args) -> ErrorType
+    {
+        return detail::make_traced_error_impl<ErrorType>::make(true, std::forward<Args>(args)...);
+    }
+
+    /// Like `go::make_traced_error`, but captures the trace only when site samples it.
+    /*!
+     * Errors that weren't sampled still implement `go::stack_trace_interface`
+     * and report an empty trace.
+     */
+    template <class ErrorType, class... Args>
+    auto make_traced_error(trace_sampler& site, Args&&... args) -> ErrorType
+    {
+        return detail::make_traced_error_impl<ErrorType>::make(site.sample(), std::forward<Args>(args)...);
+    }
+
+    /// Returns the first non-empty stack trace found in err's tree, or null if there is none.
+    /*!
+     * The returned pointer shares ownership of the error data that holds the trace,
+     * so it stays valid after err and its tree are released, and even if the traced
+     * error was created by unwrap during the search.
+     */
+    inline auto find_stack_trace(error const& err) -> std::shared_ptr<stack_trace const>
+    {
+        std::shared_ptr<stack_trace const> found;
+
+        detail::wrapping_impl::walk(err, traversal_options{}, [&](error const& node)
+        {
+            auto traced = dynamic_cast<stack_trace_interface const*>(node.operator->());
+            if (traced && !traced->trace().empty())
+                found = std::shared_ptr<stack_trace const>(node.data(), &traced->trace());
+
+            return found != nullptr;
+        });
+
+        return found;
+    }
+
+    /*! @} */
+}
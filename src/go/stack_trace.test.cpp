@@ -0,0 +1,105 @@
+#include <go/stack_trace.hpp>
+#include <go/error_chain.hpp>
+#include <go/error_string.hpp>
+
+#include <algorithm>
+
+#include <boost/ut.hpp>
+using namespace boost::ut;
+
+struct error_traced_data : public go::error_interface
+{
+	int line;
+
+	explicit error_traced_data(int line) : line(line) {}
+
+	std::string message() const override { return "bad line " + std::to_string(line); }
+};
+
+using error_traced = go::error_of<error_traced_data>;
+
+int main()
+{
+	"stack_trace"_test = [] {
+		should("capture records frames") = [] {
+			auto trace = go::stack_trace::capture();
+
+			expect(trace.empty() == false);
+			expect(trace.size <= go::stack_trace::max_frames);
+		};
+
+		should("to_string prints one line per frame") = [] {
+			auto trace = go::stack_trace::capture();
+			auto str = trace.to_string();
+
+			auto lines = static_cast<std::size_t>(std::count(str.begin(), str.end(), '\n'));
+			expect(lines == trace.size) << "got" << lines << "lines, want" << trace.size;
+		};
+	};
+
+	"make_traced_error"_test = [] {
+		should("traced error behaves as the requested error type") = [] {
+			auto err = go::make_traced_error<error_traced>(42);
+
+			expect(err->line == 42);
+			expect(err.message() == "bad line 42") << "got" << err.message();
+			expect(go::error_cast<error_traced>(go::error(err)) == err);
+		};
+
+		should("trace can be found through wrapping errors") = [] {
+			go::error err = go::make_traced_error<error_traced>(1);
+			err = go::wrap_error(std::move(err), "parsing");
+
+			auto trace = go::find_stack_trace(err);
+			expect(trace != nullptr);
+			if (trace)
+				expect(trace->empty() == false);
+
+			go::stack_trace_interface* traced = nullptr;
+			expect(go::as_error(err, traced));
+		};
+
+		should("trace outlives the error it was found in") = [] {
+			go::error err = go::wrap_error(go::make_traced_error<error_traced>(1), "parsing");
+
+			auto trace = go::find_stack_trace(err);
+			auto frames = trace ? trace->size : 0;
+			err = go::error();
+
+			expect(trace != nullptr);
+			if (trace)
+				expect(trace->size == frames && frames > 0);
+		};
+
+		should("plain errors don't have a trace") = [] {
+			auto err = go::make_error<error_traced>(1);
+
+			expect(go::find_stack_trace(err) == nullptr);
+		};
+
+		should("sampler captures one in every n errors") = [] {
+			go::trace_sampler site(3);
+
+			std::size_t traced = 0;
+			for (int i = 0; i < 9; i++)
+			{
+				auto err = go::make_traced_error<error_traced>(site, i);
+				if (go::find_stack_trace(err))
+					traced++;
+			}
+
+			expect(traced == 3_ul) << "got" << traced << "traced errors";
+		};
+
+		should("disabled sampler never captures") = [] {
+			go::trace_sampler site(0);
+			auto err = go::make_traced_error<go::error_string>(site, "x");
+
+			go::stack_trace_interface* traced = nullptr;
+			expect(go::as_error(err, traced));
+			expect(traced->trace().empty());
+		};
+	};
+
+	return 0;
+}
@@ -3,8 +3,44 @@
 #include <go/error.hpp>
 #include <go/error_cast.hpp>
 
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_set>
+#include <vector>
+
 namespace go
 {
+    /*! \addtogroup wrapping
+     * @{
+     */
+
+    /// Bounds the work `go::is_error` and `go::as_error` may spend walking an error tree.
+    /*!
+     * Errors that unwrap into themselves, directly or through other errors, would make
+     * the traversal loop forever. Once the traversal gets deeper than `cycle_check_depth`
+     * it starts remembering visited error data and skips errors it has already seen, so
+     * shallow chains never pay for the bookkeeping.
+     *
+     * Errors deeper than `max_depth` are not visited and the traversal stops after visiting
+     * `max_nodes` errors. In both cases the unvisited errors are treated as not matching.
+     */
+	struct traversal_options
+	{
+        /// Depth after which visited errors are remembered to detect unwrap cycles.
+		std::size_t cycle_check_depth = 64;
+
+        /// Errors nested deeper than this are not visited. The root error has depth 0.
+		std::size_t max_depth = std::numeric_limits<std::size_t>::max();
+
+        /// Maximum number of errors visited before the traversal gives up.
+		std::size_t max_nodes = std::numeric_limits<std::size_t>::max();
+	};
+
+    /*! @} */
+
     /// \cond TEMPLATE_DETAILS
 	namespace detail
 	{
@@ -14,151 +50,204 @@ namespace go
          */
 		struct wrapping_impl
 		{
-            /*! \brief `is_error` implementation that uses heap allocated stack and
-             *  depth-first search.
+            /*! \brief Depth-first preorder traversal of err's tree that uses a heap allocated
+             *  stack. Stops and returns true as soon as visit returns true for an error.
              */
-			template <class To>
-			static auto is_error(error err, To& target) -> bool
+			template <class Visitor>
+			static auto walk(error const& err, traversal_options const& options, Visitor&& visit) -> bool
 			{
-				if (!err && !target)
-					return true;
-
-				if (!err && target)
-					return false;
-
-				if (err && !target)
-					return false;
-
+				// Errors reached through unwrap are owned by the step. The root and errors
+				// of spans are only referenced, they stay alive while their parent does
 				struct dfsStep
 				{
-					error err;
-					int nextChildId;
+					error owned;
+					error const* borrowed;
+					std::size_t nextChildId;
+					std::size_t depth;
+
+					auto err() const -> error const&
+					{
+						return borrowed ? *borrowed : owned;
+					}
 				};
-				static std::vector<dfsStep> errWalk(4); // 4 is arbitrary
 
-				errWalk.resize(1);
-				errWalk[0] = {err, 0};
+				// The stack is reused between calls on the same thread, unless
+				// a custom is/as implementation starts a nested traversal.
+				thread_local std::vector<dfsStep> sharedWalk;
+				thread_local bool sharedWalkBusy = false;
 
-				while (!errWalk.empty())
+				std::vector<dfsStep> nestedWalk;
+				auto& errWalk = sharedWalkBusy ? nestedWalk : sharedWalk;
+
+				struct walkGuard
 				{
-					auto& errRef = errWalk.back();
+					std::vector<dfsStep>& walk;
+					bool& busy;
+					bool wasBusy;
 
-					if (!errRef.err)
+					~walkGuard()
 					{
-						errWalk.pop_back();
-						continue;
+						walk.clear();
+						busy = wasBusy;
 					}
+				} guard{errWalk, sharedWalkBusy, sharedWalkBusy};
+				sharedWalkBusy = true;
 
-					if (errRef.err == target)
-						return true;
+				// Only allocated once a chain gets deeper than cycle_check_depth
+				std::unique_ptr<std::unordered_set<error_interface const*>> seen;
 
-					if (errRef.err.is(target))
-						return true;
+				std::size_t visitedNodes = 0;
+				std::size_t maxDepth = 0;
+
+				auto finish = [&](bool found)
+				{
+#if defined(GOERROR_ENABLE_METRICS)
+					metrics_count_traversal(maxDepth, visitedNodes);
+#endif
+					return found;
+				};
 
-					go::error unwrapped;
+				errWalk.push_back({{}, &err, 0, 0});
 
-					// Skip checking unwrap if we already know that
-					// unwrap_multiple is implemented
-					if (errRef.nextChildId == 0)
-						unwrapped = errRef.err.unwrap();
+				while (!errWalk.empty())
+				{
+					auto& errRef = errWalk.back();
 
-					if (unwrapped)
+					if (!errRef.err())
 					{
-						errRef = {unwrapped, 0};
+						errWalk.pop_back();
 						continue;
 					}
 
-					auto& unwrappedErrs = errRef.err.unwrap_multiple();
-					if (unwrappedErrs.size() == 0)
+					// nextChildId is 0 only when we enter the error for the first time
+					if (errRef.nextChildId == 0)
 					{
-						errWalk.pop_back();
-						continue;
+						if (errRef.depth > options.cycle_check_depth)
+						{
+							if (!seen)
+								seen = std::make_unique<std::unordered_set<error_interface const*>>();
+
+							if (!seen->insert(errRef.err().operator->()).second)
+							{
+								errWalk.pop_back();
+								continue;
+							}
+						}
+
+						if (++visitedNodes > options.max_nodes)
+							return finish(false);
+
+						maxDepth = std::max(maxDepth, errRef.depth);
+
+						if (visit(errRef.err()))
+							return finish(true);
+
+						if (errRef.depth == options.max_depth)
+						{
+							errWalk.pop_back();
+							continue;
+						}
+
+						go::error unwrapped = errRef.err().unwrap();
+						if (unwrapped)
+						{
+							errRef = {std::move(unwrapped), nullptr, 0, errRef.depth + 1};
+							continue;
+						}
 					}
 
+					auto unwrappedErrs = errRef.err().unwrap_span();
 					if (errRef.nextChildId == unwrappedErrs.size())
 					{
 						errWalk.pop_back();
 						continue;
 					}
 
-					errWalk.push_back({unwrappedErrs[errRef.nextChildId], 0});
-					errRef.nextChildId++;
+					// push_back may invalidate errRef
+					auto childId = errRef.nextChildId++;
+					auto childDepth = errRef.depth + 1;
+					errWalk.push_back({{}, &unwrappedErrs[childId], 0, childDepth});
 				}
 
-				return false;
+				return finish(false);
 			}
 
-            /*! \brief `as_error` implementation that uses heap allocated stack and
-             *  depth-first search.
-             */
+            /// `is_error` implementation on top of `walk`.
 			template <class To>
-			static auto as_error(error err, To& target) -> bool
+			static auto is_error(error err, To& target, traversal_options const& options) -> bool
 			{
-				if (!err)
-					return false;
+				if (!err && !target)
+					return true;
 
-				struct dfsStep
-				{
-					error err;
-					int nextChildId;
-				};
-				static std::vector<dfsStep> errWalk(4); // 4 is arbitrary
+				if (!err && target)
+					return false;
 
-				errWalk.resize(1);
-				errWalk[0] = {err, 0};
+				if (err && !target)
+					return false;
 
-				while (!errWalk.empty())
+				return walk(err, options, [&](error const& node)
 				{
-					auto& errRef = errWalk.back();
-
-					if (!errRef.err)
-					{
-						errWalk.pop_back();
-						continue;
-					}
-
-					auto targetCandidate = error_cast<To>(errRef.err);
-					if (targetCandidate)
-					{
-						target = targetCandidate;
-						return true;
-					}
+					return is_match(node, target);
+				});
+			}
 
-					bool customAs = errRef.err.as(target);
-					if (customAs)
-						return true;
+            /// Reports whether a single error matches target, as `is_error` does.
+			template <class To>
+			static auto is_match(error const& node, To const& target) -> bool
+			{
+				return node == target || node.is(target);
+			}
 
-					go::error unwrapped;
+            /// `has_error` implementation on top of `walk`. Matches errors whose data is a T
+            /// or implements `go::as_interface` for Target.
+			template <class T, class Target>
+			static auto has_error(error const& err, traversal_options const& options) -> bool
+			{
+				if (!err)
+					return false;
 
-					// Skip checking unwrap if we already know that
-					// unwrap_multiple is implemented (nextChildId is not 0)
-					if (errRef.nextChildId == 0)
-						unwrapped = errRef.err.unwrap();
+				return walk(err, options, [](error const& node)
+				{
+					auto data = node.operator->();
+					return is_data_of<T>(data) || dynamic_cast<as_interface<Target> const*>(data) != nullptr;
+				});
+			}
 
-					if (unwrapped)
-					{
-						errRef = {unwrapped, 0};
-						continue;
-					}
+            /// Returns true if data is a T, comparing type IDs if T is final.
+			template <class T>
+			static auto is_data_of(error_interface const* data) -> bool
+			{
+				if constexpr (std::is_final_v<T>)
+					return typeid(*data) == typeid(T);
+				else
+					return dynamic_cast<T const*>(data) != nullptr;
+			}
 
-					auto& unwrappedErrs = errRef.err.unwrap_multiple();
-					if (unwrappedErrs.size() == 0)
-					{
-						errWalk.pop_back();
-						continue;
-					}
+            /// `as_error` implementation on top of `walk`.
+			template <class To>
+			static auto as_error(error err, To& target, traversal_options const& options) -> bool
+			{
+				if (!err)
+					return false;
 
-					if (errRef.nextChildId == unwrappedErrs.size())
-					{
-						errWalk.pop_back();
-						continue;
-					}
+				return walk(err, options, [&](error const& node)
+				{
+					return as_match(node, target);
+				});
+			}
 
-					errWalk.push_back({unwrappedErrs[errRef.nextChildId], 0});
-					errRef.nextChildId++;
+            /// Sets target and returns true if a single error matches it, as `as_error` does.
+			template <class To>
+			static auto as_match(error const& node, To& target) -> bool
+			{
+				auto targetCandidate = error_cast<To>(node);
+				if (targetCandidate)
+				{
+					target = targetCandidate;
+					return true;
 				}
 
-				return false;
+				return node.as(target);
 			}
 		};
 	} // namespace detail
@@ -171,7 +260,7 @@ namespace go
     /// `is_error` reports whether any error in err's tree matches target.
     /*!
      * The tree consists of err itself, followed by the errors obtained by repeatedly
-     * calling its unwrap() or unwrap_multiple() method. When err wraps multiple errors,
+     * calling its unwrap() or unwrap_span() method. When err wraps multiple errors,
      * `is_error` examines err followed by a depth-first traversal of its children.
      *
      * An error is considered to match a target if it is equal to that target or if
@@ -182,18 +271,27 @@ namespace go
      *
      * An `is_interface` implementation should only shallowly compare err and the target
      * and not unwrap either. 
+     *
+     * Refer to `go::traversal_options` for the limits applied to the traversal.
      */
+	template <class Against>
+	auto is_error(error err, const error_of<Against>& target, traversal_options const& options) -> bool
+	{
+		return detail::wrapping_impl::is_error(err, target, options);
+	}
+
+    /// `is_error` with default `go::traversal_options`.
 	template <class Against>
 	auto is_error(error err, const error_of<Against>& target) -> bool
 	{
-		return detail::wrapping_impl::is_error(err, target);
+		return detail::wrapping_impl::is_error(err, target, traversal_options{});
 	}
 
 	/// \brief Finds the first error in err's tree that matches target, and if one is found,
     /// sets target to that error value and returns true. Otherwise, it returns false.
     /*!
      * The tree consists of err itself, followed by the errors obtained by repeatedly
-     * calling its unwrap() or unwrap_multiple() method. When err wraps multiple
+     * calling its unwrap() or unwrap_span() method. When err wraps multiple
      * errors, `as_error` examines err followed by a depth-first traversal of its children.
      *
      * An error matches target if the error's concrete value is `go::error_cast`-able to the value
@@ -210,15 +308,81 @@ namespace go
      *
      * `as_error` produces a compile error if target is const, not convertible to bool or
      * isn't supported by `go::error_cast`.
+     *
+     * Refer to `go::traversal_options` for the limits applied to the traversal.
      */
 	template <class To>
-	auto as_error(error err, To& target) -> bool
+	auto as_error(error err, To& target, traversal_options const& options) -> bool
 	{
 		static_assert(!std::is_const_v<To>, "as_error modifies target and expects it to be non-const");
 		static_assert(std::is_convertible_v<To, bool>, "as_error expects target to be convertible to bool");
 		static_assert(std::is_class_v<std::remove_pointer_t<std::remove_cv_t<To>>> || std::is_same_v<std::remove_cv_t<To>, void*>, "as_error expects target's type to be viable dynamic_cast target");
 
-		return detail::wrapping_impl::as_error(err, target);
+		return detail::wrapping_impl::as_error(err, target, options);
+	}
+
+    /// `as_error` with default `go::traversal_options`.
+	template <class To>
+	auto as_error(error err, To& target) -> bool
+	{
+		return go::as_error(err, target, traversal_options{});
+	}
+
+    /// \cond TEMPLATE_DETAILS
+	namespace detail
+	{
+		// The data type of T, and the target `go::as_error` would take to find it
+		template <class T>
+		struct has_error_data
+		{
+			using type = T;
+			using target = T*;
+		};
+
+		template <class Impl>
+		struct has_error_data<error_of<Impl>>
+		{
+			using type = Impl;
+			using target = error_of<Impl>;
+		};
+	} // namespace detail
+    /// \endcond
+
+    /// Reports whether any error in err's tree has type T, without needing a target.
+    /*!
+     * T is either an error type, like `go::error_code`, or a type its error data may
+     * derive from, like error data or an interface:
+     *
+     * ```
+     * if (go::has_error<go::error_code>(err) || go::has_error<retryable_interface>(err))
+     *     retry();
+     * ```
+     *
+     * The tree is walked as by `go::is_error`. Nodes are checked with a single type ID
+     * comparison if the data type is final, and with `dynamic_cast` otherwise. Nothing
+     * is written and the found node isn't copied, so unlike `go::as_error` the check
+     * doesn't touch its reference count.
+     *
+     * Like `go::as_error`, errors that implement `go::as_interface` for the target
+     * `go::as_error` would take, T for error types and a pointer to T otherwise, are
+     * found too, so has_error returns true exactly when as_error would succeed.
+     *
+     * Refer to `go::traversal_options` for the limits applied to the traversal.
+     */
+	template <class T>
+	auto has_error(error const& err, traversal_options const& options) -> bool
+	{
+		using data_type = typename detail::has_error_data<T>::type;
+		static_assert(std::is_class_v<data_type>, "has_error expects an error type or a class type");
+
+		return detail::wrapping_impl::has_error<data_type, typename detail::has_error_data<T>::target>(err, options);
+	}
+
+    /// `has_error` with default `go::traversal_options`.
+	template <class T>
+	auto has_error(error const& err) -> bool
+	{
+		return go::has_error<T>(err, traversal_options{});
 	}
 
     /*! @} */
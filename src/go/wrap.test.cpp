@@ -203,6 +203,36 @@ struct error_pure_wrapped_data : public go::error_interface
 
 using error_pure_wrapped = go::error_of<error_pure_wrapped_data>;
 
+// Error with mutable wrapped errors that can be made to point back at itself
+struct error_cycle_data : public go::error_interface
+{
+	go::error next;
+	std::vector<go::error> nexts;
+
+	std::string message() const override { return "cycle"; }
+	go::error unwrap() const override { return next; }
+	const std::vector<go::error>& unwrap_multiple() const override { return nexts; }
+};
+
+using error_cycle = go::error_of<error_cycle_data>;
+
+// Final, so has_error compares type IDs instead of casting
+struct error_final_data final : public go::error_interface
+{
+	std::string message() const override { return "final"; }
+};
+
+using error_final = go::error_of<error_final_data>;
+
+// Builds a chain of error_wrapped of the given length on top of err
+go::error wrapTimes(go::error err, int times)
+{
+	for (int i = 0; i < times; i++)
+		err = go::make_error<error_wrapped>("wrap", err);
+
+	return err;
+}
+
 std::pair<std::ifstream, go::error> openFile(std::filesystem::path name)
 {
 	if (name.empty())
@@ -437,7 +467,8 @@ int main()
 		// Won't compile, string is not convertible to bool
 		//asValidationTestCase(err, str, "std::string");
 
-		struct { operator bool() { return true; } }* omg{};
+		struct omg_type { operator bool() { return true; } };
+		omg_type* omg{};
 		asValidationTestCase(err, omg, "OMG type");
 	};
 
@@ -493,5 +524,162 @@ int main()
 		expect(err1 == errUnwrapped) << "got unwrapped error differs from the original, want to be the same";
 	};
 
+	"traversal limits"_test = []
+	{
+		auto errT = go::make_error<error_T>("T");
+
+		should("is_error terminates on an error that unwraps to itself") = [&]
+		{
+			auto cycle = go::make_error<error_cycle>();
+			cycle->next = cycle;
+
+			expect(go::is_error(cycle, errT) == false);
+			expect(go::is_error(cycle, cycle) == true);
+
+			cycle->next = {};
+		};
+
+		should("as_error terminates on a cycle through unwrap_multiple") = [&]
+		{
+			auto cycle = go::make_error<error_cycle>();
+			cycle->nexts = {go::make_error<error_wrapped>("wrap", cycle), go::errorf("x"), errT};
+
+			error_T target;
+			bool got = go::as_error(cycle, target);
+			expect(got == true) << "got" << got << "want true";
+			expect(target == errT) << "got" << target << "want" << errT;
+
+			can_timeout* timeout = nullptr;
+			expect(go::as_error(cycle, timeout) == false);
+
+			cycle->nexts.clear();
+		};
+
+		should("cycle detection kicks in after a small cycle check depth") = [&]
+		{
+			auto cycle = go::make_error<error_cycle>();
+			cycle->next = go::make_error<error_wrapped>("a", go::make_error<error_wrapped>("b", cycle));
+
+			go::traversal_options opts;
+			opts.cycle_check_depth = 0;
+
+			expect(go::is_error(cycle, errT, opts) == false);
+
+			cycle->next = {};
+		};
+
+		should("errors deeper than max_depth are not visited") = [&]
+		{
+			auto err = wrapTimes(errT, 10);
+
+			go::traversal_options opts;
+
+			opts.max_depth = 9;
+			expect(go::is_error(err, errT, opts) == false);
+
+			opts.max_depth = 10;
+			expect(go::is_error(err, errT, opts) == true);
+
+			auto multi = go::make_error<error_multi>(go::errorf("a"), wrapTimes(errT, 2));
+			error_T target;
+
+			opts.max_depth = 2;
+			expect(go::as_error(multi, target, opts) == false);
+
+			opts.max_depth = 3;
+			expect(go::as_error(multi, target, opts) == true);
+		};
+
+		should("traversal stops after max_nodes visited errors") = [&]
+		{
+			auto multi = go::make_error<error_multi>(go::errorf("a"), go::errorf("b"), errT);
+
+			go::traversal_options opts;
+
+			opts.max_nodes = 3;
+			expect(go::is_error(multi, errT, opts) == false);
+
+			opts.max_nodes = 4;
+			expect(go::is_error(multi, errT, opts) == true);
+		};
+
+		should("nested traversal from a custom is doesn't disturb the outer one") = [&]
+		{
+			auto inner = wrapTimes(errT, 3);
+			auto poser = go::make_error<error_poser>("nested", [&](go::error target)
+			{
+				return go::is_error(inner, target);
+			});
+
+			auto err = go::make_error<error_multi>(go::errorf("a"), poser, go::errorf("b"));
+
+			expect(go::is_error(err, go::error(errT)) == true);
+			expect(go::is_error(err, go::errorf("c")) == false);
+		};
+	};
+
+	"has_error"_test = []
+	{
+		should("find error types in chains and lists") = []
+		{
+			auto code = go::make_error<go::error_code>(std::make_error_code(std::errc::timed_out));
+			auto err = go::make_error<error_multi>(go::errorf("a"), wrapTimes(code, 3));
+
+			expect(go::has_error<go::error_code>(err) == true);
+			expect(go::has_error<go::error_code_data>(err) == true);
+			expect(go::has_error<error_wrapped>(err) == true);
+			expect(go::has_error<error_T>(err) == false);
+			expect(go::has_error<go::error_code>(go::error()) == false);
+		};
+
+		should("compare final types exactly") = []
+		{
+			auto err = wrapTimes(go::make_error<error_final>(), 2);
+
+			expect(go::has_error<error_final>(err) == true);
+			expect(go::has_error<error_final>(wrapTimes(go::errorf("a"), 2)) == false);
+		};
+
+		should("find interfaces") = []
+		{
+			auto err = wrapTimes(go::make_error<error_fs_path>("open", "file"), 2);
+
+			expect(go::has_error<can_timeout>(err) == true);
+			expect(go::has_error<can_timeout>(wrapTimes(go::errorf("a"), 2)) == false);
+		};
+
+		should("agree with as_error on as_interface") = []
+		{
+			auto err = go::make_error<error_poser>("poser", [](go::error) { return false; });
+
+			error_T target;
+			expect(go::as_error(err, target) == true);
+			expect(go::has_error<error_T>(err) == true);
+			expect(go::has_error<error_T>(wrapTimes(err, 2)) == true);
+		};
+
+		should("not copy the found error") = []
+		{
+			auto code = go::make_error<go::error_code>(std::make_error_code(std::errc::timed_out));
+			auto err = go::make_error<error_multi>(go::errorf("a"), code);
+
+			auto uses = code.data().use_count();
+			expect(go::has_error<go::error_code>(err) == true);
+			expect(code.data().use_count() == uses);
+		};
+
+		should("respect traversal limits") = []
+		{
+			auto err = wrapTimes(go::make_error<error_final>(), 5);
+
+			go::traversal_options opts;
+			opts.max_depth = 4;
+			expect(go::has_error<error_final>(err, opts) == false);
+
+			opts.max_depth = 5;
+			expect(go::has_error<error_final>(err, opts) == true);
+		};
+	};
+
 	return 0;
 }